@@ -1,789 +1,4776 @@
-#ifndef ListOperationsKit_H
-#define ListOperationsKit_H
-
-#include <memory>
-#include <sstream>
-#include <random>
-#include <unordered_set>
-#include <algorithm>
-#include <iterator>
-#include <initializer_list>
-#include <type_traits>
-
-template<typename T>
-class stack {
-public:
-    virtual ~stack() = default;
-
-    virtual bool empty() const = 0;
-    virtual size_t size() const = 0;
-    virtual T& top() = 0;
-    virtual const T& top() const = 0;
-    virtual void pop() = 0;
-    virtual void push(const T& theElement) = 0;
-    virtual void push(T&& theElement) = 0;
-};
-
-template<typename T>
-class queue {
-public:
-    virtual ~queue() = default;
-
-    virtual bool empty() const = 0;
-    virtual size_t size() const = 0;
-    virtual T& front() = 0;
-    virtual const T& front() const = 0;
-    virtual T& back() = 0;
-    virtual const T& back() const = 0;
-    virtual void pop() = 0;
-    virtual void push(const T& theElement) = 0;
-    virtual void push(T&& theElement) = 0;
-};
-
-template<typename T>
-struct DoublyChainNode {
-    T element;
-    std::unique_ptr<DoublyChainNode<T>> next;
-    DoublyChainNode<T>* prev;
-    
-    DoublyChainNode() : prev(nullptr) {}
-    
-    explicit DoublyChainNode(const T& element) 
-        : element(element), prev(nullptr) {}
-    
-    explicit DoublyChainNode(T&& element) 
-        : element(std::move(element)), prev(nullptr) {}
-    
-    DoublyChainNode(const T& element, std::unique_ptr<DoublyChainNode<T>> next, DoublyChainNode<T>* prev = nullptr)
-        : element(element), next(std::move(next)), prev(prev) {}
-    
-    DoublyChainNode(T&& element, std::unique_ptr<DoublyChainNode<T>> next, DoublyChainNode<T>* prev = nullptr)
-        : element(std::move(element)), next(std::move(next)), prev(prev) {}
-};
-
-template<typename T>
-class ListOperationsKit {
-private:
-    std::unique_ptr<DoublyChainNode<T>> head;
-    DoublyChainNode<T>* tail;
-    size_t list_size;
-
-public:
-    using value_type = T;
-    using size_type = size_t;
-    using difference_type = std::ptrdiff_t;
-    using reference = T&;
-    using const_reference = const T&;
-    using pointer = T*;
-    using const_pointer = const T*;
-
-    class iterator {
-        friend class ListOperationsKit<T>;
-    private:
-        DoublyChainNode<T>* node;
-    public:
-        explicit iterator(DoublyChainNode<T>* n = nullptr) : node(n) {}
-        T& operator*() const { return node->element; }
-        iterator& operator++() { 
-            if (node) node = node->next.get(); 
-            return *this; 
-        }
-        bool operator!=(const iterator& other) const { return node != other.node; }
-    };
-
-    class const_iterator {
-        friend class ListOperationsKit<T>;
-    private:
-        const DoublyChainNode<T>* node;
-    public:
-        explicit const_iterator(const DoublyChainNode<T>* n = nullptr) : node(n) {}
-        const T& operator*() const { return node->element; }
-        const_iterator& operator++() { 
-            if (node) node = node->next.get(); 
-            return *this; 
-        }
-        bool operator!=(const const_iterator& other) const { return node != other.node; }
-    };
-
-    ListOperationsKit() : tail(nullptr), list_size(0) {}
-
-    ListOperationsKit(const ListOperationsKit& other) : tail(nullptr), list_size(0) {
-        for (const auto& item : other) {
-            push_back(item);
-        }
-    }
-
-    ListOperationsKit(ListOperationsKit&& other) noexcept 
-        : head(std::move(other.head)), tail(other.tail), list_size(other.list_size) {
-        other.tail = nullptr;
-        other.list_size = 0;
-    }
-
-    ListOperationsKit(std::initializer_list<T> init) : tail(nullptr), list_size(0) {
-        for (const auto& item : init) {
-            push_back(item);
-        }
-    }
-
-    ~ListOperationsKit() = default;
-
-    iterator begin() { return iterator(head.get()); }
-    const_iterator begin() const { return const_iterator(head.get()); }
-    const_iterator cbegin() const { return const_iterator(head.get()); }
-    
-    iterator end() { return iterator(nullptr); }
-    const_iterator end() const { return const_iterator(nullptr); }
-    const_iterator cend() const { return const_iterator(nullptr); }
-
-    bool empty() const noexcept { return list_size == 0; }
-    size_t size() const noexcept { return list_size; }
-    size_t max_size() const noexcept { return std::numeric_limits<size_t>::max(); }
-
-    reference front() {
-        if (empty()) throw std::out_of_range("List is empty");
-        return head->element;
-    }
-
-    const_reference front() const {
-        if (empty()) throw std::out_of_range("List is empty");
-        return head->element;
-    }
-
-    reference back() {
-        if (empty()) throw std::out_of_range("List is empty");
-        return tail->element;
-    }
-
-    const_reference back() const {
-        if (empty()) throw std::out_of_range("List is empty");
-        return tail->element;
-    }
-
-    void clear() noexcept {
-        head.reset();
-        tail = nullptr;
-        list_size = 0;
-    }
-
-    void push_front(const T& value) {
-        auto new_node = std::make_unique<DoublyChainNode<T>>(value);
-        if (empty()) {
-            tail = new_node.get();
-        } else {
-            head->prev = new_node.get();
-            new_node->next = std::move(head);
-        }
-        head = std::move(new_node);
-        ++list_size;
-    }
-
-    void push_front(T&& value) {
-        auto new_node = std::make_unique<DoublyChainNode<T>>(std::move(value));
-        if (empty()) {
-            tail = new_node.get();
-        } else {
-            head->prev = new_node.get();
-            new_node->next = std::move(head);
-        }
-        head = std::move(new_node);
-        ++list_size;
-    }
-
-    void push_back(const T& value) {
-        auto new_node = std::make_unique<DoublyChainNode<T>>(value);
-        if (empty()) {
-            head = std::move(new_node);
-            tail = head.get();
-        } else {
-            new_node->prev = tail;
-            tail->next = std::move(new_node);
-            tail = tail->next.get();
-        }
-        ++list_size;
-    }
-
-    void push_back(T&& value) {
-        auto new_node = std::make_unique<DoublyChainNode<T>>(std::move(value));
-        if (empty()) {
-            head = std::move(new_node);
-            tail = head.get();
-        } else {
-            new_node->prev = tail;
-            tail->next = std::move(new_node);
-            tail = tail->next.get();
-        }
-        ++list_size;
-    }
-
-    void append(const T& element) { 
-        push_back(element); 
-    }
-    
-    void append(T&& element) { 
-        push_back(std::move(element)); 
-    }
-
-    template<typename... Args>
-    void append(const T& element, Args&&... args) {
-        push_back(element);
-        append(std::forward<Args>(args)...);
-    }
-
-    template<typename... Args>
-    void emplace_back(Args&&... args) {
-        auto new_node = std::make_unique<DoublyChainNode<T>>(T(std::forward<Args>(args)...));
-        if (empty()) {
-            head = std::move(new_node);
-            tail = head.get();
-        } else {
-            new_node->prev = tail;
-            tail->next = std::move(new_node);
-            tail = tail->next.get();
-        }
-        ++list_size;
-    }
-
-    template<typename... Args>
-    void emplace_front(Args&&... args) {
-        auto new_node = std::make_unique<DoublyChainNode<T>>(T(std::forward<Args>(args)...));
-        if (empty()) {
-            tail = new_node.get();
-        } else {
-            head->prev = new_node.get();
-            new_node->next = std::move(head);
-        }
-        head = std::move(new_node);
-        ++list_size;
-    }
-
-    void pop_front() {
-        if (empty()) throw std::out_of_range("List is empty");
-        
-        if (list_size == 1) {
-            head.reset();
-            tail = nullptr;
-        } else {
-            head = std::move(head->next);
-            head->prev = nullptr;
-        }
-        --list_size;
-    }
-
-    void pop_back() {
-        if (empty()) throw std::out_of_range("List is empty");
-        
-        if (list_size == 1) {
-            head.reset();
-            tail = nullptr;
-        } else {
-            tail = tail->prev;
-            tail->next.reset();
-        }
-        --list_size;
-    }
-
-    void insert_at(size_t index, const T& element) {
-        if (index > list_size) throw std::out_of_range("Index out of bounds");
-        
-        if (index == 0) {
-            push_front(element);
-        } else if (index == list_size) {
-            push_back(element);
-        } else {
-            auto new_node = std::make_unique<DoublyChainNode<T>>(element);
-            DoublyChainNode<T>* current = head.get();
-            
-            for (size_t i = 0; i < index; ++i) {
-                current = current->next.get();
-            }
-            
-            DoublyChainNode<T>* prev_node = current->prev;
-            new_node->prev = prev_node;
-            new_node->next = std::move(prev_node->next);
-            new_node->next->prev = new_node.get();
-            prev_node->next = std::move(new_node);
-            
-            ++list_size;
-        }
-    }
-
-    void remove(size_t index) {
-        if (index >= list_size) throw std::out_of_range("Index out of bounds");
-        
-        if (index == 0) {
-            pop_front();
-        } else if (index == list_size - 1) {
-            pop_back();
-        } else {
-            DoublyChainNode<T>* current = head.get();
-            
-            for (size_t i = 0; i < index; ++i) {
-                current = current->next.get();
-            }
-            
-            DoublyChainNode<T>* prev_node = current->prev;
-            DoublyChainNode<T>* next_node = current->next.get();
-            
-            prev_node->next = std::move(current->next);
-            next_node->prev = prev_node;
-            
-            --list_size;
-        }
-    }
-
-    void random_append(size_t length, T min = T{}, T max = T{100}) {
-        std::random_device rd;
-        std::mt19937 gen(rd());
-        
-        if constexpr (std::is_integral_v<T>) {
-            std::uniform_int_distribution<T> dis(min, max);
-            std::unordered_set<T> generated;
-            
-            for (size_t i = 0; i < length; ++i) {
-                T value;
-                do {
-                    value = dis(gen);
-                } while (generated.find(value) != generated.end());
-                
-                push_back(value);
-                generated.insert(value);
-            }
-        } else {
-            std::uniform_real_distribution<T> dis(min, max);
-            for (size_t i = 0; i < length; ++i) {
-                push_back(dis(gen));
-            }
-        }
-    }
-
-    void concatenate(const ListOperationsKit<T>& other) {
-        for (const auto& item : other) {
-            push_back(item);
-        }
-    }
-
-    void reverse() noexcept {
-        if (list_size <= 1) return;
-        
-        DoublyChainNode<T>* current = head.release();
-        DoublyChainNode<T>* prev = nullptr;
-        
-        tail = current;
-        
-        while (current) {
-            DoublyChainNode<T>* next = current->next.release();
-
-            current->next.reset(prev);
-            current->prev = next;
-            
-            prev = current;
-            current = next;
-        }
-
-        head.reset(prev);
-    }
-
-    void sort() {
-        if (list_size <= 1) return;
-        
-        std::vector<T> temp;
-        temp.reserve(list_size);
-
-        for (const auto& item : *this) {
-            temp.push_back(item);
-        }
-
-        std::sort(temp.begin(), temp.end());
-
-        auto it = begin();
-        for (const auto& item : temp) {
-            *it = item;
-            ++it;
-        }
-    }
-
-    template<typename Compare>
-    void sort(Compare comp) {
-        if (list_size <= 1) return;
-        
-        std::vector<T> temp;
-        temp.reserve(list_size);
-
-        for (const auto& item : *this) {
-            temp.push_back(item);
-        }
-        
-        std::sort(temp.begin(), temp.end(), comp);
-
-        auto it = begin();
-        for (const auto& item : temp) {
-            *it = item;
-            ++it;
-        }
-    }
-
-    void sort(bool descending) {
-        if (descending) {
-            sort(std::greater<T>());
-        } else {
-            sort();
-        }
-    }
-
-    void swap(size_t index1, size_t index2) {
-        if (index1 >= list_size || index2 >= list_size) {
-            throw std::out_of_range("Index out of bounds");
-        }
-        
-        if (index1 == index2) return;
-        
-        T temp = get(index1);
-        set(index1, get(index2));
-        set(index2, temp);
-    }
-
-    void set(size_t index, const T& value) {
-        if (index >= list_size) throw std::out_of_range("Index out of bounds");
-        
-        DoublyChainNode<T>* current = head.get();
-        for (size_t i = 0; i < index; ++i) {
-            current = current->next.get();
-        }
-        current->element = value;
-    }
-
-    void set(size_t index, T&& value) {
-        if (index >= list_size) throw std::out_of_range("Index out of bounds");
-        
-        DoublyChainNode<T>* current = head.get();
-        for (size_t i = 0; i < index; ++i) {
-            current = current->next.get();
-        }
-        current->element = std::move(value);
-    }
-
-    T get(size_t index) const {
-        if (index >= list_size) throw std::out_of_range("Index out of bounds");
-        
-        const DoublyChainNode<T>* current = head.get();
-        for (size_t i = 0; i < index; ++i) {
-            current = current->next.get();
-        }
-        return current->element;
-    }
-
-    T& operator[](size_t index) {
-        DoublyChainNode<T>* current = head.get();
-        for (size_t i = 0; i < index; ++i) {
-            current = current->next.get();
-        }
-        return current->element;
-    }
-
-    const T& operator[](size_t index) const {
-        const DoublyChainNode<T>* current = head.get();
-        for (size_t i = 0; i < index; ++i) {
-            current = current->next.get();
-        }
-        return current->element;
-    }
-
-    T operator()(size_t index) const {
-        return get(index);
-    }
-
-    ListOperationsKit& operator=(const ListOperationsKit& rhs) {
-        if (this != &rhs) {
-            clear();
-            for (const auto& item : rhs) {
-                push_back(item);
-            }
-        }
-        return *this;
-    }
-
-    ListOperationsKit& operator=(ListOperationsKit&& rhs) noexcept {
-        if (this != &rhs) {
-            head = std::move(rhs.head);
-            tail = rhs.tail;
-            list_size = rhs.list_size;
-            rhs.tail = nullptr;
-            rhs.list_size = 0;
-        }
-        return *this;
-    }
-
-    ListOperationsKit& operator=(std::initializer_list<T> init) {
-        clear();
-        for (const auto& item : init) {
-            push_back(item);
-        }
-        return *this;
-    }
-
-    ListOperationsKit slice(size_t start, size_t end, size_t step = 1) const {
-        ListOperationsKit result;
-        if (start >= list_size || step == 0) return result;
-        
-        for (size_t i = start; i < end && i < list_size; i += step) {
-            result.push_back(get(i));
-        }
-        
-        return result;
-    }
-
-    ListOperationsKit copy() const {
-        return ListOperationsKit(*this);
-    }
-
-    size_t count(const T& element) const {
-        size_t cnt = 0;
-        const DoublyChainNode<T>* current = head.get();
-        while (current) {
-            if (current->element == element) {
-                ++cnt;
-            }
-            current = current->next.get();
-        }
-        return cnt;
-    }
-
-    size_t index(const T& element) const {
-        const DoublyChainNode<T>* current = head.get();
-        size_t idx = 0;
-        while (current) {
-            if (current->element == element) {
-                return idx;
-            }
-            current = current->next.get();
-            ++idx;
-        }
-        throw std::out_of_range("Element not found in list");
-    }
-
-    void print() const {
-        for (const auto& item : *this) {
-            std::cout << item << " ";
-        }
-        std::cout << std::endl;
-    }
-
-    void print_reverse() const {
-        for (int i = static_cast<int>(list_size) - 1; i >= 0; --i) {
-            std::cout << get(i) << " ";
-        }
-        std::cout << std::endl;
-    }
-
-    std::string to_string() const {
-        std::stringstream ss;
-        auto it = cbegin();
-        while (it != cend()) {
-            ss << *it;
-            if (++it != cend()) {
-                ss << " ";
-            }
-        }
-        return ss.str();
-    }
-
-    friend std::ostream& operator<<(std::ostream& os, const ListOperationsKit& list) {
-        for (const auto& item : list) {
-            os << item << " ";
-        }
-        return os;
-    }
-
-    bool operator==(const ListOperationsKit& other) const {
-        if (list_size != other.list_size) return false;
-        
-        const DoublyChainNode<T>* current1 = head.get();
-        const DoublyChainNode<T>* current2 = other.head.get();
-        
-        while (current1 && current2) {
-            if (current1->element != current2->element) return false;
-            current1 = current1->next.get();
-            current2 = current2->next.get();
-        }
-        
-        return true;
-    }
-
-    bool operator!=(const ListOperationsKit& other) const {
-        return !(*this == other);
-    }
-
-    bool operator<(const ListOperationsKit& other) const {
-        const DoublyChainNode<T>* current1 = head.get();
-        const DoublyChainNode<T>* current2 = other.head.get();
-        
-        while (current1 && current2) {
-            if (current1->element < current2->element) return true;
-            if (current2->element < current1->element) return false;
-            current1 = current1->next.get();
-            current2 = current2->next.get();
-        }
-        
-        return !current1 && current2;
-    }
-
-    bool operator<=(const ListOperationsKit& other) const {
-        return !(other < *this);
-    }
-
-    bool operator>(const ListOperationsKit& other) const {
-        return other < *this;
-    }
-
-    bool operator>=(const ListOperationsKit& other) const {
-        return !(*this < other);
-    }
-
-    size_t get_size() const { return list_size; }
-    size_t length() const { return list_size; }
-};
-
-template<typename T>
-class LinkedStack : public stack<T> {
-private:
-    std::unique_ptr<DoublyChainNode<T>> stack_top;
-    size_t stack_size;
-
-public:
-    LinkedStack() : stack_size(0) {}
-    ~LinkedStack() = default;
-
-    bool empty() const override { return stack_size == 0; }
-    size_t size() const override { return stack_size; }
-
-    T& top() override {
-        if (empty()) throw std::runtime_error("Invalid operation on empty stack");
-        return stack_top->element;
-    }
-
-    const T& top() const override {
-        if (empty()) throw std::runtime_error("Invalid operation on empty stack");
-        return stack_top->element;
-    }
-
-    void pop() override {
-        if (empty()) throw std::runtime_error("Invalid operation on empty stack");
-        stack_top = std::move(stack_top->next);
-        --stack_size;
-    }
-
-    void push(const T& element) override {
-        auto new_node = std::make_unique<DoublyChainNode<T>>(element);
-        new_node->next = std::move(stack_top);
-        stack_top = std::move(new_node);
-        ++stack_size;
-    }
-
-    void push(T&& element) override {
-        auto new_node = std::make_unique<DoublyChainNode<T>>(std::move(element));
-        new_node->next = std::move(stack_top);
-        stack_top = std::move(new_node);
-        ++stack_size;
-    }
-
-    template<typename... Args>
-    void emplace(Args&&... args) {
-        auto new_node = std::make_unique<DoublyChainNode<T>>(T(std::forward<Args>(args)...));
-        new_node->next = std::move(stack_top);
-        stack_top = std::move(new_node);
-        ++stack_size;
-    }
-};
-
-template<typename T>
-class LinkedQueue : public queue<T> {
-private:
-    std::unique_ptr<DoublyChainNode<T>> queue_front;
-    DoublyChainNode<T>* queue_back;
-    size_t queue_size;
-
-public:
-    LinkedQueue() : queue_back(nullptr), queue_size(0) {}
-    ~LinkedQueue() = default;
-
-    bool empty() const override { return queue_size == 0; }
-    size_t size() const override { return queue_size; }
-
-    T& front() override {
-        if (empty()) throw std::runtime_error("Invalid operation on empty queue");
-        return queue_front->element;
-    }
-
-    const T& front() const override {
-        if (empty()) throw std::runtime_error("Invalid operation on empty queue");
-        return queue_front->element;
-    }
-
-    T& back() override {
-        if (empty()) throw std::runtime_error("Invalid operation on empty queue");
-        return queue_back->element;
-    }
-
-    const T& back() const override {
-        if (empty()) throw std::runtime_error("Invalid operation on empty queue");
-        return queue_back->element;
-    }
-
-    void pop() override {
-        if (empty()) throw std::runtime_error("Invalid operation on empty queue");
-        
-        if (queue_size == 1) {
-            queue_front.reset();
-            queue_back = nullptr;
-        } else {
-            queue_front = std::move(queue_front->next);
-            queue_front->prev = nullptr;
-        }
-        --queue_size;
-    }
-
-    void push(const T& element) override {
-        auto new_node = std::make_unique<DoublyChainNode<T>>(element);
-        
-        if (empty()) {
-            queue_back = new_node.get();
-            queue_front = std::move(new_node);
-        } else {
-            new_node->prev = queue_back;
-            queue_back->next = std::move(new_node);
-            queue_back = queue_back->next.get();
-        }
-        ++queue_size;
-    }
-
-    void push(T&& element) override {
-        auto new_node = std::make_unique<DoublyChainNode<T>>(std::move(element));
-        
-        if (empty()) {
-            queue_back = new_node.get();
-            queue_front = std::move(new_node);
-        } else {
-            new_node->prev = queue_back;
-            queue_back->next = std::move(new_node);
-            queue_back = queue_back->next.get();
-        }
-        ++queue_size;
-    }
-
-    template<typename... Args>
-    void emplace(Args&&... args) {
-        auto new_node = std::make_unique<DoublyChainNode<T>>(T(std::forward<Args>(args)...));
-        
-        if (empty()) {
-            queue_back = new_node.get();
-            queue_front = std::move(new_node);
-        } else {
-            new_node->prev = queue_back;
-            queue_back->next = std::move(new_node);
-            queue_back = queue_back->next.get();
-        }
-        ++queue_size;
-    }
-};
-
+#ifndef ListOperationsKit_H
+#define ListOperationsKit_H
+
+#include <memory>
+#include <sstream>
+#include <random>
+#include <unordered_set>
+#include <unordered_map>
+#include <algorithm>
+#include <iterator>
+#include <initializer_list>
+#include <type_traits>
+#include <limits>
+#include <vector>
+#include <ranges>
+#include <new>
+#include <utility>
+#include <stdexcept>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <atomic>
+#include <optional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <future>
+#include <exception>
+#include <coroutine>
+#include <memory_resource>
+#include <tuple>
+#include <deque>
+
+template<typename T>
+class stack {
+public:
+    virtual ~stack() = default;
+
+    virtual bool empty() const = 0;
+    virtual size_t size() const = 0;
+    virtual T& top() = 0;
+    virtual const T& top() const = 0;
+    virtual void pop() = 0;
+    virtual void push(const T& theElement) = 0;
+    virtual void push(T&& theElement) = 0;
+};
+
+template<typename T>
+class queue {
+public:
+    virtual ~queue() = default;
+
+    virtual bool empty() const = 0;
+    virtual size_t size() const = 0;
+    virtual T& front() = 0;
+    virtual const T& front() const = 0;
+    virtual T& back() = 0;
+    virtual const T& back() const = 0;
+    virtual void pop() = 0;
+    virtual void push(const T& theElement) = 0;
+    virtual void push(T&& theElement) = 0;
+};
+
+template<typename T>
+class priority_queue {
+public:
+    virtual ~priority_queue() = default;
+
+    virtual bool empty() const = 0;
+    virtual size_t size() const = 0;
+    virtual const T& top() const = 0;
+    virtual void pop() = 0;
+    virtual void push(const T& theElement) = 0;
+    virtual void push(T&& theElement) = 0;
+};
+
+#if defined(__GNUC__) || defined(__clang__)
+#define LIST_OPERATIONS_KIT_PREFETCH(address) __builtin_prefetch(address)
+#else
+#define LIST_OPERATIONS_KIT_PREFETCH(address) ((void)0)
+#endif
+
+inline constexpr size_t cache_line_size = 64;
+
+// Links come first so a forward walk reads next from the start of the node;
+// a non-zero Alignment over-aligns (and pads) each node, e.g. to a cache line.
+template<typename T, size_t Alignment = 0>
+struct alignas(std::max({Alignment, alignof(T), alignof(void*)})) DoublyChainNode {
+    DoublyChainNode* next;
+    DoublyChainNode* prev;
+    T element;
+    
+    DoublyChainNode() : next(nullptr), prev(nullptr) {}
+    
+    explicit DoublyChainNode(const T& element) 
+        : next(nullptr), prev(nullptr), element(element) {}
+    
+    explicit DoublyChainNode(T&& element) 
+        : next(nullptr), prev(nullptr), element(std::move(element)) {}
+    
+    template<typename... Args>
+    explicit DoublyChainNode(std::in_place_t, Args&&... args)
+        : next(nullptr), prev(nullptr), element(std::forward<Args>(args)...) {}
+    
+    DoublyChainNode(const T& element, DoublyChainNode* next, DoublyChainNode* prev = nullptr)
+        : next(next), prev(prev), element(element) {}
+    
+    DoublyChainNode(T&& element, DoublyChainNode* next, DoublyChainNode* prev = nullptr)
+        : next(next), prev(prev), element(std::move(element)) {}
+};
+
+template<typename Node>
+inline void prefetch_ahead(const Node* node) noexcept {
+    if (node->next) LIST_OPERATIONS_KIT_PREFETCH(node->next->next);
+}
+
+template<typename T, size_t Alignment = 0>
+class HeapNodeStorage {
+public:
+    using node_type = DoublyChainNode<T, Alignment>;
+
+    static constexpr bool nodes_follow_move = true;
+
+private:
+    struct NodeBlock {
+        node_type* nodes;
+        size_t capacity;
+        size_t used;
+        size_t live;
+    };
+
+    struct CompactionState {
+        std::vector<NodeBlock> blocks;
+        size_t churn = 0;
+        double threshold = 0.0;
+    };
+
+    std::unique_ptr<CompactionState> compaction;
+
+    static constexpr bool over_aligned = alignof(node_type) > __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+    static void release_block(const NodeBlock& block) noexcept {
+        if constexpr (over_aligned) {
+            ::operator delete(block.nodes, std::align_val_t(alignof(node_type)));
+        } else {
+            ::operator delete(block.nodes);
+        }
+    }
+
+    CompactionState& compaction_state() {
+        if (!compaction) compaction = std::make_unique<CompactionState>();
+        return *compaction;
+    }
+
+public:
+    HeapNodeStorage() = default;
+    HeapNodeStorage(const HeapNodeStorage&) noexcept {}
+    HeapNodeStorage& operator=(const HeapNodeStorage&) noexcept { return *this; }
+    HeapNodeStorage(HeapNodeStorage&&) noexcept = default;
+    HeapNodeStorage& operator=(HeapNodeStorage&&) noexcept = default;
+
+    ~HeapNodeStorage() {
+        if (!compaction) return;
+        for (const auto& block : compaction->blocks) {
+            release_block(block);
+        }
+    }
+
+    template<typename... Args>
+    node_type* create(Args&&... args) {
+        if (compaction) ++compaction->churn;
+        return new node_type(std::forward<Args>(args)...);
+    }
+
+    void destroy(node_type* node) noexcept {
+        if (!compaction) {
+            delete node;
+            return;
+        }
+        
+        ++compaction->churn;
+        auto& blocks = compaction->blocks;
+        for (auto it = blocks.begin(); it != blocks.end(); ++it) {
+            if (node >= it->nodes && node < it->nodes + it->capacity) {
+                node->~node_type();
+                if (--it->live == 0) {
+                    release_block(*it);
+                    blocks.erase(it);
+                }
+                return;
+            }
+        }
+        delete node;
+    }
+
+    bool transferable(const node_type* node, const HeapNodeStorage&) const noexcept {
+        if (!compaction) return true;
+        for (const auto& block : compaction->blocks) {
+            if (node >= block.nodes && node < block.nodes + block.capacity) return false;
+        }
+        return true;
+    }
+
+    bool transferable_all(const HeapNodeStorage&) const noexcept {
+        return !compaction || compaction->blocks.empty();
+    }
+
+    void begin_block(size_t capacity) {
+        auto& state = compaction_state();
+        state.blocks.reserve(state.blocks.size() + 1);
+        
+        void* memory;
+        if constexpr (over_aligned) {
+            memory = ::operator new(capacity * sizeof(node_type), std::align_val_t(alignof(node_type)));
+        } else {
+            memory = ::operator new(capacity * sizeof(node_type));
+        }
+        state.blocks.push_back(NodeBlock{static_cast<node_type*>(memory), capacity, 0, 0});
+    }
+
+    void end_block() noexcept {
+        compaction->churn = 0;
+    }
+
+    void abort_block() noexcept {
+        auto& blocks = compaction->blocks;
+        if (blocks.back().live == 0) {
+            release_block(blocks.back());
+            blocks.pop_back();
+        }
+    }
+
+    template<typename... Args>
+    node_type* create_in_block(Args&&... args) {
+        NodeBlock& block = compaction->blocks.back();
+        node_type* node = ::new (static_cast<void*>(block.nodes + block.used)) node_type(std::forward<Args>(args)...);
+        ++block.used;
+        ++block.live;
+        return node;
+    }
+
+    void set_compact_threshold(double churn_ratio) {
+        compaction_state().threshold = churn_ratio;
+    }
+
+    bool should_compact(size_t list_size) const noexcept {
+        return compaction && compaction->threshold > 0.0 && list_size > 0 &&
+               static_cast<double>(compaction->churn) > compaction->threshold * static_cast<double>(list_size);
+    }
+};
+
+template<typename T, size_t N>
+class InlineNodeStorage {
+public:
+    using node_type = DoublyChainNode<T>;
+
+    static constexpr bool nodes_follow_move = false;
+
+private:
+    union Slot {
+        Slot* next_free;
+        alignas(node_type) unsigned char bytes[sizeof(node_type)];
+    };
+
+    Slot slots[N];
+    Slot* free_slots;
+    size_t slots_used;
+
+    bool owns(const node_type* node) const noexcept {
+        auto address = reinterpret_cast<const unsigned char*>(node);
+        return address >= reinterpret_cast<const unsigned char*>(slots) &&
+               address < reinterpret_cast<const unsigned char*>(slots + N);
+    }
+
+public:
+    InlineNodeStorage() noexcept : free_slots(nullptr), slots_used(0) {}
+    InlineNodeStorage(const InlineNodeStorage&) noexcept : InlineNodeStorage() {}
+    InlineNodeStorage& operator=(const InlineNodeStorage&) noexcept { return *this; }
+
+    template<typename... Args>
+    node_type* create(Args&&... args) {
+        Slot* slot = nullptr;
+        if (free_slots) {
+            slot = free_slots;
+            free_slots = slot->next_free;
+        } else if (slots_used < N) {
+            slot = &slots[slots_used++];
+        } else {
+            return new node_type(std::forward<Args>(args)...);
+        }
+        
+        try {
+            return ::new (static_cast<void*>(slot->bytes)) node_type(std::forward<Args>(args)...);
+        } catch (...) {
+            slot->next_free = free_slots;
+            free_slots = slot;
+            throw;
+        }
+    }
+
+    void destroy(node_type* node) noexcept {
+        if (!owns(node)) {
+            delete node;
+            return;
+        }
+        node->~node_type();
+        Slot* slot = reinterpret_cast<Slot*>(node);
+        slot->next_free = free_slots;
+        free_slots = slot;
+    }
+
+    bool transferable(const node_type* node, const InlineNodeStorage&) const noexcept {
+        return !owns(node);
+    }
+
+    bool transferable_all(const InlineNodeStorage&) const noexcept {
+        return slots_used == 0;
+    }
+
+    size_t inline_capacity() const noexcept { return N; }
+};
+
+// Nodes come from a std::pmr::memory_resource. Over a monotonic_buffer_resource, nodes of a
+// trivially destructible T need no per-node free, so containers drop the whole chain in O(1)
+// and leave the memory to the arena's release().
+template<typename T>
+class PmrNodeStorage {
+public:
+    using node_type = DoublyChainNode<T>;
+
+    static constexpr bool nodes_follow_move = true;
+
+private:
+    std::pmr::memory_resource* resource;
+    bool arena;
+
+public:
+    PmrNodeStorage() noexcept : PmrNodeStorage(std::pmr::get_default_resource()) {}
+
+    explicit PmrNodeStorage(std::pmr::memory_resource* resource) noexcept
+        : resource(resource ? resource : std::pmr::get_default_resource()),
+          arena(dynamic_cast<std::pmr::monotonic_buffer_resource*>(this->resource) != nullptr) {}
+
+    // Like std::pmr containers, a copy starts on the default resource rather than sharing the
+    // source's arena, which may not outlive it.
+    PmrNodeStorage(const PmrNodeStorage&) noexcept : PmrNodeStorage() {}
+    PmrNodeStorage& operator=(const PmrNodeStorage&) noexcept { return *this; }
+    PmrNodeStorage(PmrNodeStorage&&) noexcept = default;
+    PmrNodeStorage& operator=(PmrNodeStorage&&) noexcept = default;
+
+    template<typename... Args>
+    node_type* create(Args&&... args) {
+        void* memory = resource->allocate(sizeof(node_type), alignof(node_type));
+        try {
+            return ::new (memory) node_type(std::forward<Args>(args)...);
+        } catch (...) {
+            resource->deallocate(memory, sizeof(node_type), alignof(node_type));
+            throw;
+        }
+    }
+
+    void destroy(node_type* node) noexcept {
+        node->~node_type();
+        resource->deallocate(node, sizeof(node_type), alignof(node_type));
+    }
+
+    bool transferable(const node_type*, const PmrNodeStorage& destination) const noexcept {
+        return resource == destination.resource || resource->is_equal(*destination.resource);
+    }
+
+    bool transferable_all(const PmrNodeStorage& destination) const noexcept {
+        return transferable(nullptr, destination);
+    }
+
+    bool releases_in_bulk() const noexcept {
+        return arena && std::is_trivially_destructible_v<T>;
+    }
+
+    std::pmr::memory_resource* memory_resource() const noexcept { return resource; }
+};
+
+// Storage policies without releases_in_bulk() always free node by node.
+template<typename NodeStorage>
+inline bool releases_in_bulk(const NodeStorage& storage) noexcept {
+    if constexpr (requires { storage.releases_in_bulk(); }) {
+        return storage.releases_in_bulk();
+    } else {
+        return false;
+    }
+}
+
+template<typename Iterator>
+class ListSliceView : public std::ranges::view_interface<ListSliceView<Iterator>> {
+private:
+    Iterator first;
+    size_t start_pos;
+    size_t end_pos;
+    size_t step;
+
+public:
+    class iterator {
+    private:
+        Iterator current;
+        size_t pos;
+        size_t step;
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using iterator_concept = std::forward_iterator_tag;
+        using value_type = typename std::iterator_traits<Iterator>::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = typename std::iterator_traits<Iterator>::pointer;
+        using reference = typename std::iterator_traits<Iterator>::reference;
+
+        iterator() : pos(0), step(1) {}
+        iterator(Iterator it, size_t p, size_t s) : current(it), pos(p), step(s) {}
+        reference operator*() const { return *current; }
+        pointer operator->() const { return &*current; }
+        iterator& operator++() {
+            for (size_t i = 0; i < step; ++i) ++current;
+            pos += step;
+            return *this;
+        }
+        iterator operator++(int) {
+            iterator tmp = *this;
+            ++*this;
+            return tmp;
+        }
+        bool operator==(const iterator& other) const { return pos == other.pos; }
+        bool operator!=(const iterator& other) const { return pos != other.pos; }
+    };
+
+    ListSliceView() : start_pos(0), end_pos(0), step(1) {}
+
+    ListSliceView(Iterator list_begin, size_t list_size, size_t start, size_t end, size_t step)
+        : first(list_begin), start_pos(start), end_pos(start), step(step) {
+        if (step == 0 || start >= list_size || start >= end) return;
+        size_t last = std::min(end, list_size);
+        end_pos = start + ((last - start + step - 1) / step) * step;
+        std::advance(first, start);
+    }
+
+    iterator begin() const { return iterator(first, start_pos, step); }
+    iterator end() const { return iterator(Iterator(), end_pos, step); }
+    size_t size() const { return (end_pos - start_pos) / step; }
+};
+
+template<typename T>
+concept RadixSortable = (std::is_integral_v<T> && !std::is_same_v<T, bool>) ||
+                        (std::is_floating_point_v<T> && std::numeric_limits<T>::is_iec559 &&
+                         (sizeof(T) == sizeof(uint32_t) || sizeof(T) == sizeof(uint64_t)));
+
+template<RadixSortable T>
+struct RadixKey {
+    using key_type = typename std::conditional_t<std::is_integral_v<T>, std::make_unsigned<T>,
+        std::type_identity<std::conditional_t<sizeof(T) == sizeof(uint32_t), uint32_t, uint64_t>>>::type;
+
+    static constexpr key_type sign_bit = key_type(1) << (sizeof(key_type) * 8 - 1);
+
+    static key_type encode(T value) noexcept {
+        if constexpr (std::is_floating_point_v<T>) {
+            key_type bits = std::bit_cast<key_type>(value);
+            return (bits & sign_bit) ? key_type(~bits) : key_type(bits | sign_bit);
+        } else if constexpr (std::is_signed_v<T>) {
+            return key_type(static_cast<key_type>(value) ^ sign_bit);
+        } else {
+            return value;
+        }
+    }
+
+    static T decode(key_type key) noexcept {
+        if constexpr (std::is_floating_point_v<T>) {
+            return std::bit_cast<T>((key & sign_bit) ? key_type(key & ~sign_bit) : key_type(~key));
+        } else if constexpr (std::is_signed_v<T>) {
+            return static_cast<T>(key_type(key ^ sign_bit));
+        } else {
+            return key;
+        }
+    }
+};
+
+template<typename Item, typename KeyOf>
+void lsd_radix_sort(std::vector<Item>& items, KeyOf key_of) {
+    using key_type = std::remove_cvref_t<decltype(key_of(items.front()))>;
+    constexpr size_t passes = sizeof(key_type);
+    
+    if (items.size() <= 1) return;
+    
+    std::vector<std::array<size_t, 256>> counts(passes);
+    for (const auto& item : items) {
+        key_type key = key_of(item);
+        for (size_t pass = 0; pass < passes; ++pass) {
+            ++counts[pass][(key >> (pass * 8)) & 0xff];
+        }
+    }
+    
+    std::vector<Item> buffer(items.size());
+    Item* source = items.data();
+    Item* destination = buffer.data();
+    
+    for (size_t pass = 0; pass < passes; ++pass) {
+        auto& count = counts[pass];
+        if (count[(key_of(*source) >> (pass * 8)) & 0xff] == items.size()) continue;
+        
+        size_t offset = 0;
+        for (auto& bucket : count) {
+            size_t bucket_size = bucket;
+            bucket = offset;
+            offset += bucket_size;
+        }
+        
+        for (size_t i = 0; i < items.size(); ++i) {
+            destination[count[(key_of(source[i]) >> (pass * 8)) & 0xff]++] = std::move(source[i]);
+        }
+        std::swap(source, destination);
+    }
+    
+    if (source != items.data()) {
+        items.swap(buffer);
+    }
+}
+
+template<typename T>
+class ValueIndexBase {
+public:
+    virtual ~ValueIndexBase() = default;
+
+    virtual void insert(const T& value) = 0;
+    virtual void erase(const T& value) = 0;
+    virtual size_t count(const T& value) const = 0;
+    virtual void clear() noexcept = 0;
+};
+
+template<typename T, typename Hash = std::hash<T>, typename KeyEqual = std::equal_to<T>>
+class HashValueIndex : public ValueIndexBase<T> {
+private:
+    std::unordered_map<T, size_t, Hash, KeyEqual> counts;
+
+public:
+    void insert(const T& value) override { ++counts[value]; }
+
+    void erase(const T& value) override {
+        auto it = counts.find(value);
+        if (it == counts.end()) return;
+        if (--it->second == 0) counts.erase(it);
+    }
+
+    size_t count(const T& value) const override {
+        auto it = counts.find(value);
+        return it == counts.end() ? 0 : it->second;
+    }
+
+    void clear() noexcept override { counts.clear(); }
+};
+
+// Aggregate policies. ListOperationsKit and LinkedQueue report every element that enters or
+// leaves the container through on_insert/on_erase, so the aggregates are kept current instead of
+// being recomputed by a scan. The default NoAggregates is empty and its hooks compile to nothing.
+// Elements modified through a reference (operator[], front(), iterators) bypass the hooks; use
+// set() or set_many() on aggregating lists.
+struct NoAggregates {
+    static constexpr bool fifo_only = false;
+
+    template<typename T> void on_insert(const T&) noexcept {}
+    template<typename T> void on_erase(const T&) noexcept {}
+    void on_clear() noexcept {}
+    void absorb(NoAggregates&) noexcept {}
+};
+
+template<typename T>
+class SumAggregate {
+private:
+    T total;
+
+public:
+    static constexpr bool fifo_only = false;
+
+    SumAggregate() : total() {}
+
+    void on_insert(const T& value) { total += value; }
+    void on_erase(const T& value) { total -= value; }
+    void on_clear() noexcept { total = T(); }
+
+    void absorb(SumAggregate& other) {
+        total += other.total;
+        other.total = T();
+    }
+
+    T sum() const { return total; }
+};
+
+// Order-independent min/max. Inserts update the extremes in O(1); erasing the current minimum or
+// maximum only marks it stale, and the next min()/max() rescans the elements once.
+template<typename T>
+class MinMaxAggregate {
+private:
+    mutable T low;
+    mutable T high;
+    mutable bool low_current;
+    mutable bool high_current;
+    size_t tracked;
+
+public:
+    static constexpr bool fifo_only = false;
+
+    MinMaxAggregate() : low(), high(), low_current(false), high_current(false), tracked(0) {}
+
+    void on_insert(const T& value) {
+        if (tracked++ == 0) {
+            low = value;
+            high = value;
+            low_current = true;
+            high_current = true;
+            return;
+        }
+        if (low_current && value < low) low = value;
+        if (high_current && high < value) high = value;
+    }
+
+    void on_erase(const T& value) noexcept {
+        --tracked;
+        if (low_current && !(low < value)) low_current = false;
+        if (high_current && !(value < high)) high_current = false;
+    }
+
+    void on_clear() noexcept {
+        tracked = 0;
+        low_current = false;
+        high_current = false;
+    }
+
+    void absorb(MinMaxAggregate& other) {
+        if (other.tracked == 0) return;
+        if (tracked == 0) {
+            std::swap(*this, other);
+            return;
+        }
+        tracked += other.tracked;
+        low_current = low_current && other.low_current;
+        high_current = high_current && other.high_current;
+        if (low_current && other.low < low) low = other.low;
+        if (high_current && high < other.high) high = other.high;
+        other.on_clear();
+    }
+
+    template<typename Range>
+    const T& min(const Range& elements) const {
+        if (!low_current) {
+            low = *std::min_element(std::ranges::begin(elements), std::ranges::end(elements));
+            low_current = true;
+        }
+        return low;
+    }
+
+    template<typename Range>
+    const T& max(const Range& elements) const {
+        if (!high_current) {
+            high = *std::max_element(std::ranges::begin(elements), std::ranges::end(elements));
+            high_current = true;
+        }
+        return high;
+    }
+};
+
+// Sliding-window min/max for FIFO containers (LinkedQueue): two monotonic deques hold the
+// candidates, so push, pop, min() and max() are all amortized O(1). It relies on elements leaving
+// in insertion order, so ListOperationsKit rejects it.
+template<typename T>
+class WindowMinMaxAggregate {
+private:
+    std::deque<T> ascending;
+    std::deque<T> descending;
+
+public:
+    static constexpr bool fifo_only = true;
+
+    void on_insert(const T& value) {
+        while (!ascending.empty() && value < ascending.back()) ascending.pop_back();
+        while (!descending.empty() && descending.back() < value) descending.pop_back();
+        ascending.push_back(value);
+        descending.push_back(value);
+    }
+
+    void on_erase(const T& value) noexcept {
+        if (!(ascending.front() < value)) ascending.pop_front();
+        if (!(value < descending.front())) descending.pop_front();
+    }
+
+    void on_clear() noexcept {
+        ascending.clear();
+        descending.clear();
+    }
+
+    template<typename Container>
+    const T& min(const Container&) const noexcept { return ascending.front(); }
+
+    template<typename Container>
+    const T& max(const Container&) const noexcept { return descending.front(); }
+};
+
+// Combines several policies; each query (sum, min, max) must come from exactly one of them.
+template<typename... Policies>
+struct Aggregates : Policies... {
+    static constexpr bool fifo_only = (Policies::fifo_only || ...);
+
+    template<typename T>
+    void on_insert(const T& value) {
+        (Policies::on_insert(value), ...);
+    }
+
+    template<typename T>
+    void on_erase(const T& value) noexcept {
+        (Policies::on_erase(value), ...);
+    }
+
+    void on_clear() noexcept {
+        (Policies::on_clear(), ...);
+    }
+
+    void absorb(Aggregates& other) {
+        (Policies::absorb(static_cast<Policies&>(other)), ...);
+    }
+};
+
+template<typename T, typename NodeStorage = HeapNodeStorage<T>, typename Aggregate = NoAggregates>
+class ListOperationsKit {
+    static_assert(!Aggregate::fifo_only, "FIFO-only aggregates (WindowMinMaxAggregate) need a LinkedQueue");
+
+public:
+    using node_type = typename NodeStorage::node_type;
+
+private:
+    node_type* head;
+    node_type* tail;
+    size_t list_size;
+    bool reversed_order;
+    [[no_unique_address]] NodeStorage storage;
+    std::unique_ptr<ValueIndexBase<T>> value_index;
+    [[no_unique_address]] Aggregate aggregate;
+
+    template<typename> friend class ShardedListOperationsKit;
+
+    // Every element entering or leaving the list passes through these (or insert_node), which
+    // keeps the hash index and the aggregate policy in step with the contents.
+    void index_insert(const T& value) {
+        if (value_index) value_index->insert(value);
+        if constexpr (!std::is_same_v<Aggregate, NoAggregates>) {
+            try {
+                aggregate.on_insert(value);
+            } catch (...) {
+                if (value_index) value_index->erase(value);
+                throw;
+            }
+        }
+    }
+
+    void index_erase(const T& value) {
+        if (value_index) value_index->erase(value);
+        aggregate.on_erase(value);
+    }
+
+    template<typename... Args>
+    node_type* create_node(Args&&... args) {
+        return storage.create(std::forward<Args>(args)...);
+    }
+
+    void destroy_node(node_type* node) noexcept {
+        storage.destroy(node);
+    }
+
+    // reverse() only flips reversed_order, so head/tail and next/prev are physical links and these
+    // give the logical ones. Order-insensitive code (unlinking, clear, compaction) uses the physical links.
+    node_type* first() const noexcept { return reversed_order ? tail : head; }
+    node_type* last() const noexcept { return reversed_order ? head : tail; }
+    node_type* after(const node_type* node) const noexcept { return reversed_order ? node->prev : node->next; }
+    node_type* before(const node_type* node) const noexcept { return reversed_order ? node->next : node->prev; }
+
+    void prefetch_after(const node_type* node) const noexcept {
+        if (const node_type* next = after(node)) LIST_OPERATIONS_KIT_PREFETCH(after(next));
+    }
+
+    // Inserts node in front of position in logical order; nullptr appends.
+    node_type* insert_node(node_type* position, node_type* node) {
+        try {
+            index_insert(node->element);
+        } catch (...) {
+            destroy_node(node);
+            throw;
+        }
+        return link_node(position, node);
+    }
+
+    // Links an already accounted-for node in front of position in logical order; nullptr appends.
+    node_type* link_node(node_type* position, node_type* node) noexcept {
+        if (reversed_order) position = position ? position->next : head;
+        node->next = position;
+        node->prev = position ? position->prev : tail;
+        if (node->prev) {
+            node->prev->next = node;
+        } else {
+            head = node;
+        }
+        if (position) {
+            position->prev = node;
+        } else {
+            tail = node;
+        }
+        ++list_size;
+        return node;
+    }
+
+    node_type* unlink_node(node_type* node) noexcept {
+        if (node->prev) {
+            node->prev->next = node->next;
+        } else {
+            head = node->next;
+        }
+        if (node->next) {
+            node->next->prev = node->prev;
+        } else {
+            tail = node->prev;
+        }
+        node->next = nullptr;
+        node->prev = nullptr;
+        --list_size;
+        return node;
+    }
+
+    void erase_node(node_type* node) {
+        index_erase(node->element);
+        destroy_node(unlink_node(node));
+    }
+
+    // Relinks all nodes in the order given, resetting the list to forward orientation.
+    void relink(const std::vector<node_type*>& nodes) noexcept {
+        for (size_t i = 0; i < nodes.size(); ++i) {
+            nodes[i]->prev = i > 0 ? nodes[i - 1] : nullptr;
+            nodes[i]->next = i + 1 < nodes.size() ? nodes[i + 1] : nullptr;
+        }
+        head = nodes.front();
+        tail = nodes.back();
+        reversed_order = false;
+    }
+
+    // Everything that can throw (this list's index/aggregate update, copying a node tied to
+    // source's storage) runs before node leaves source, so a failure leaves both lists unchanged.
+    void transfer_node(node_type* position, ListOperationsKit& source, node_type* node) {
+        index_insert(node->element);
+        node_type* moved = node;
+        if (!source.storage.transferable(node, storage)) {
+            try {
+                moved = create_node(std::move_if_noexcept(node->element));
+            } catch (...) {
+                index_erase(node->element);
+                throw;
+            }
+        }
+        source.index_erase(moved->element);
+        source.unlink_node(node);
+        if (moved != node) source.destroy_node(node);
+        link_node(position, moved);
+    }
+
+    node_type* node_at(size_t index) const noexcept {
+        node_type* current;
+        if (index < list_size / 2) {
+            current = first();
+            for (size_t i = 0; i < index; ++i) {
+                current = after(current);
+            }
+        } else {
+            current = last();
+            for (size_t i = list_size - 1; i > index; --i) {
+                current = before(current);
+            }
+        }
+        return current;
+    }
+
+    // Resolves every index with one walk from whichever end is closer to the requested range.
+    // Results keep the order of indices; with allow_end, index == size() maps to nullptr.
+    std::vector<node_type*> nodes_at(std::span<const size_t> indices, bool allow_end = false) const {
+        std::vector<std::pair<size_t, size_t>> order;
+        order.reserve(indices.size());
+        for (size_t slot = 0; slot < indices.size(); ++slot) {
+            if (indices[slot] > list_size || (indices[slot] == list_size && !allow_end)) {
+                throw std::out_of_range("Index out of bounds");
+            }
+            order.emplace_back(indices[slot], slot);
+        }
+        std::sort(order.begin(), order.end());
+        
+        std::vector<node_type*> nodes(indices.size());
+        if (order.empty()) return nodes;
+        
+        if (order.back().first <= list_size - order.front().first) {
+            node_type* current = first();
+            size_t position = 0;
+            for (const auto& [index, slot] : order) {
+                for (; position < index; ++position) {
+                    current = after(current);
+                }
+                nodes[slot] = current;
+            }
+        } else {
+            node_type* current = nullptr;
+            size_t position = list_size;
+            for (auto it = order.rbegin(); it != order.rend(); ++it) {
+                for (; position > it->first; --position) {
+                    current = current ? before(current) : last();
+                }
+                nodes[it->second] = current;
+            }
+        }
+        return nodes;
+    }
+
+    void take(ListOperationsKit& other) noexcept(NodeStorage::nodes_follow_move) {
+        auto index = std::move(other.value_index);
+        if constexpr (NodeStorage::nodes_follow_move) {
+            std::swap(storage, other.storage);
+            std::swap(aggregate, other.aggregate);
+            head = other.head;
+            tail = other.tail;
+            list_size = other.list_size;
+            reversed_order = other.reversed_order;
+            other.head = nullptr;
+            other.tail = nullptr;
+            other.list_size = 0;
+            other.reversed_order = false;
+        } else {
+            for (auto& item : other) {
+                push_back(std::move(item));
+            }
+            other.clear();
+        }
+        value_index = std::move(index);
+    }
+
+    static constexpr size_t radix_sort_threshold = 256;
+
+    void radix_sort(bool descending) {
+        using encoded_type = typename RadixKey<T>::key_type;
+        const encoded_type mask = descending ? encoded_type(~encoded_type(0)) : encoded_type(0);
+        
+        std::vector<encoded_type> keys;
+        keys.reserve(list_size);
+        for (const node_type* current = first(); current; current = after(current)) {
+            keys.push_back(encoded_type(RadixKey<T>::encode(current->element) ^ mask));
+        }
+        
+        lsd_radix_sort(keys, [](encoded_type key) { return key; });
+        
+        node_type* current = first();
+        for (encoded_type key : keys) {
+            current->element = RadixKey<T>::decode(encoded_type(key ^ mask));
+            current = after(current);
+        }
+    }
+
+    void maybe_compact() {
+        if constexpr (requires { storage.should_compact(list_size); }) {
+            if (storage.should_compact(list_size)) compact();
+        }
+    }
+
+public:
+    using value_type = T;
+    using size_type = size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using pointer = T*;
+    using const_pointer = const T*;
+
+    class iterator {
+        friend class ListOperationsKit;
+    private:
+        node_type* node;
+        const ListOperationsKit* owner;
+        bool reversed;
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using iterator_concept = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T*;
+        using reference = T&;
+
+        iterator() : node(nullptr), owner(nullptr), reversed(false) {}
+        explicit iterator(node_type* n, const ListOperationsKit* o = nullptr)
+            : node(n), owner(o), reversed(o && o->reversed_order) {}
+        T& operator*() const { return node->element; }
+        T* operator->() const { return &node->element; }
+        iterator& operator++() { 
+            if (node) node = reversed ? node->prev : node->next; 
+            return *this; 
+        }
+        iterator operator++(int) {
+            iterator tmp = *this;
+            ++*this;
+            return tmp;
+        }
+        iterator& operator--() {
+            if (node) {
+                node = reversed ? node->next : node->prev;
+            } else {
+                node = reversed ? owner->head : owner->tail;
+            }
+            return *this;
+        }
+        iterator operator--(int) {
+            iterator tmp = *this;
+            --*this;
+            return tmp;
+        }
+        bool operator==(const iterator& other) const { return node == other.node; }
+        bool operator!=(const iterator& other) const { return node != other.node; }
+    };
+
+    class const_iterator {
+        friend class ListOperationsKit;
+    private:
+        const node_type* node;
+        const ListOperationsKit* owner;
+        bool reversed;
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using iterator_concept = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        const_iterator() : node(nullptr), owner(nullptr), reversed(false) {}
+        explicit const_iterator(const node_type* n, const ListOperationsKit* o = nullptr)
+            : node(n), owner(o), reversed(o && o->reversed_order) {}
+        const_iterator(const iterator& it) : node(it.node), owner(it.owner), reversed(it.reversed) {}
+        const T& operator*() const { return node->element; }
+        const T* operator->() const { return &node->element; }
+        const_iterator& operator++() { 
+            if (node) node = reversed ? node->prev : node->next; 
+            return *this; 
+        }
+        const_iterator operator++(int) {
+            const_iterator tmp = *this;
+            ++*this;
+            return tmp;
+        }
+        const_iterator& operator--() {
+            if (node) {
+                node = reversed ? node->next : node->prev;
+            } else {
+                node = reversed ? owner->head : owner->tail;
+            }
+            return *this;
+        }
+        const_iterator operator--(int) {
+            const_iterator tmp = *this;
+            --*this;
+            return tmp;
+        }
+        bool operator==(const const_iterator& other) const { return node == other.node; }
+        bool operator!=(const const_iterator& other) const { return node != other.node; }
+    };
+
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    ListOperationsKit() : head(nullptr), tail(nullptr), list_size(0), reversed_order(false) {}
+
+    ListOperationsKit(const ListOperationsKit& other) : head(nullptr), tail(nullptr), list_size(0), reversed_order(false) {
+        for (const auto& item : other) {
+            push_back(item);
+        }
+    }
+
+    ListOperationsKit(ListOperationsKit&& other) noexcept(NodeStorage::nodes_follow_move)
+        : head(nullptr), tail(nullptr), list_size(0), reversed_order(false) {
+        take(other);
+    }
+
+    ListOperationsKit(std::initializer_list<T> init) : head(nullptr), tail(nullptr), list_size(0), reversed_order(false) {
+        for (const auto& item : init) {
+            push_back(item);
+        }
+    }
+
+    explicit ListOperationsKit(std::pmr::memory_resource* resource)
+        requires std::constructible_from<NodeStorage, std::pmr::memory_resource*>
+        : head(nullptr), tail(nullptr), list_size(0), reversed_order(false), storage(resource) {}
+
+    ListOperationsKit(std::initializer_list<T> init, std::pmr::memory_resource* resource)
+        requires std::constructible_from<NodeStorage, std::pmr::memory_resource*>
+        : ListOperationsKit(resource) {
+        for (const auto& item : init) {
+            push_back(item);
+        }
+    }
+
+    std::pmr::memory_resource* get_memory_resource() const noexcept
+        requires requires (const NodeStorage& policy) { policy.memory_resource(); } {
+        return storage.memory_resource();
+    }
+
+    ~ListOperationsKit() {
+        clear();
+    }
+
+    iterator begin() { return iterator(first(), this); }
+    const_iterator begin() const { return const_iterator(first(), this); }
+    const_iterator cbegin() const { return const_iterator(first(), this); }
+    
+    iterator end() { return iterator(nullptr, this); }
+    const_iterator end() const { return const_iterator(nullptr, this); }
+    const_iterator cend() const { return const_iterator(nullptr, this); }
+
+    reverse_iterator rbegin() { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+    const_reverse_iterator crbegin() const { return const_reverse_iterator(cend()); }
+
+    reverse_iterator rend() { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+    const_reverse_iterator crend() const { return const_reverse_iterator(cbegin()); }
+
+    bool empty() const noexcept { return list_size == 0; }
+    size_t size() const noexcept { return list_size; }
+    size_t max_size() const noexcept { return std::numeric_limits<size_t>::max(); }
+
+    reference front() {
+        if (empty()) throw std::out_of_range("List is empty");
+        return first()->element;
+    }
+
+    const_reference front() const {
+        if (empty()) throw std::out_of_range("List is empty");
+        return first()->element;
+    }
+
+    reference back() {
+        if (empty()) throw std::out_of_range("List is empty");
+        return last()->element;
+    }
+
+    const_reference back() const {
+        if (empty()) throw std::out_of_range("List is empty");
+        return last()->element;
+    }
+
+    void clear() noexcept {
+        node_type* current = releases_in_bulk(storage) ? nullptr : head;
+        while (current) {
+            node_type* next = current->next;
+            destroy_node(current);
+            current = next;
+        }
+        head = nullptr;
+        tail = nullptr;
+        list_size = 0;
+        reversed_order = false;
+        if (value_index) value_index->clear();
+        aggregate.on_clear();
+    }
+
+    template<typename Hash = std::hash<T>, typename KeyEqual = std::equal_to<T>>
+    void enable_index() {
+        auto index = std::make_unique<HashValueIndex<T, Hash, KeyEqual>>();
+        for (const auto& item : *this) {
+            index->insert(item);
+        }
+        value_index = std::move(index);
+    }
+
+    void disable_index() noexcept { value_index.reset(); }
+
+    bool has_index() const noexcept { return value_index != nullptr; }
+
+    void rebuild_index() {
+        if (!value_index) return;
+        value_index->clear();
+        for (const auto& item : *this) {
+            value_index->insert(item);
+        }
+    }
+
+    // Available when the Aggregate policy tracks them.
+    T sum() const requires requires (const Aggregate& policy) { policy.sum(); } {
+        return aggregate.sum();
+    }
+
+    const T& min() const requires requires (const Aggregate& policy, const ListOperationsKit& list) { policy.min(list); } {
+        if (empty()) throw std::out_of_range("List is empty");
+        return aggregate.min(*this);
+    }
+
+    const T& max() const requires requires (const Aggregate& policy, const ListOperationsKit& list) { policy.max(list); } {
+        if (empty()) throw std::out_of_range("List is empty");
+        return aggregate.max(*this);
+    }
+
+    void push_front(const T& value) {
+        insert_node(first(), create_node(value));
+        maybe_compact();
+    }
+
+    void push_front(T&& value) {
+        insert_node(first(), create_node(std::move(value)));
+        maybe_compact();
+    }
+
+    void push_back(const T& value) {
+        insert_node(nullptr, create_node(value));
+        maybe_compact();
+    }
+
+    void push_back(T&& value) {
+        insert_node(nullptr, create_node(std::move(value)));
+        maybe_compact();
+    }
+
+    void append(const T& element) { 
+        push_back(element); 
+    }
+    
+    void append(T&& element) { 
+        push_back(std::move(element)); 
+    }
+
+    template<typename... Args>
+    void append(const T& element, Args&&... args) {
+        push_back(element);
+        append(std::forward<Args>(args)...);
+    }
+
+    template<typename... Args>
+    void emplace_back(Args&&... args) {
+        insert_node(nullptr, create_node(std::in_place, std::forward<Args>(args)...));
+        maybe_compact();
+    }
+
+    template<typename... Args>
+    void emplace_front(Args&&... args) {
+        insert_node(first(), create_node(std::in_place, std::forward<Args>(args)...));
+        maybe_compact();
+    }
+
+    void pop_front() {
+        if (empty()) throw std::out_of_range("List is empty");
+        erase_node(first());
+        maybe_compact();
+    }
+
+    void pop_back() {
+        if (empty()) throw std::out_of_range("List is empty");
+        erase_node(last());
+        maybe_compact();
+    }
+
+    void insert_at(size_t index, const T& element) {
+        if (index > list_size) throw std::out_of_range("Index out of bounds");
+        insert_node(index == list_size ? nullptr : node_at(index), create_node(element));
+        maybe_compact();
+    }
+
+    void remove(size_t index) {
+        if (index >= list_size) throw std::out_of_range("Index out of bounds");
+        erase_node(node_at(index));
+        maybe_compact();
+    }
+
+    template<typename Predicate>
+    size_t erase_if(Predicate pred) {
+        size_t removed = 0;
+        node_type* current = first();
+        while (current) {
+            node_type* next = after(current);
+            if (pred(std::as_const(current->element))) {
+                erase_node(current);
+                ++removed;
+            }
+            current = next;
+        }
+        if (removed) maybe_compact();
+        return removed;
+    }
+
+    size_t remove_value(const T& value) {
+        if (value_index && value_index->count(value) == 0) return 0;
+        return erase_if([&value](const T& element) { return element == value; });
+    }
+
+    template<typename BinaryPredicate = std::equal_to<T>>
+    size_t unique(BinaryPredicate pred = BinaryPredicate()) {
+        size_t removed = 0;
+        node_type* current = first();
+        while (current && after(current)) {
+            node_type* next = after(current);
+            if (pred(std::as_const(current->element), std::as_const(next->element))) {
+                erase_node(next);
+                ++removed;
+            } else {
+                current = next;
+            }
+        }
+        if (removed) maybe_compact();
+        return removed;
+    }
+
+    template<typename Compare = std::less<T>>
+    void merge(ListOperationsKit& other, Compare comp = Compare()) {
+        if (&other == this) return;
+        
+        node_type* current = first();
+        while (node_type* theirs = other.first()) {
+            while (current && !comp(theirs->element, current->element)) {
+                current = after(current);
+            }
+            transfer_node(current, other, theirs);
+        }
+        maybe_compact();
+    }
+
+    template<typename Compare = std::less<T>>
+    void merge(ListOperationsKit&& other, Compare comp = Compare()) {
+        merge(other, comp);
+    }
+
+    template<typename Compare = std::less<T>>
+    void set_union(ListOperationsKit& other, Compare comp = Compare()) {
+        if (&other == this) return;
+        
+        node_type* current = first();
+        while (node_type* theirs = other.first()) {
+            while (current && comp(current->element, theirs->element)) {
+                current = after(current);
+            }
+            if (current && !comp(theirs->element, current->element)) {
+                other.erase_node(theirs);
+                current = after(current);
+            } else {
+                transfer_node(current, other, theirs);
+            }
+        }
+        maybe_compact();
+    }
+
+    template<typename Compare = std::less<T>>
+    void set_union(ListOperationsKit&& other, Compare comp = Compare()) {
+        set_union(other, comp);
+    }
+
+    template<typename Compare = std::less<T>>
+    void set_intersection(const ListOperationsKit& other, Compare comp = Compare()) {
+        if (&other == this) return;
+        
+        node_type* current = first();
+        const node_type* theirs = other.first();
+        while (current) {
+            node_type* next = after(current);
+            while (theirs && comp(theirs->element, current->element)) {
+                theirs = other.after(theirs);
+            }
+            if (theirs && !comp(current->element, theirs->element)) {
+                theirs = other.after(theirs);
+            } else {
+                erase_node(current);
+            }
+            current = next;
+        }
+        maybe_compact();
+    }
+
+    template<typename Compare = std::less<T>>
+    void set_difference(const ListOperationsKit& other, Compare comp = Compare()) {
+        if (&other == this) {
+            clear();
+            return;
+        }
+        
+        node_type* current = first();
+        const node_type* theirs = other.first();
+        while (current && theirs) {
+            node_type* next = after(current);
+            if (comp(theirs->element, current->element)) {
+                theirs = other.after(theirs);
+                continue;
+            }
+            if (!comp(current->element, theirs->element)) {
+                erase_node(current);
+                theirs = other.after(theirs);
+            }
+            current = next;
+        }
+        maybe_compact();
+    }
+
+    void compact() requires requires (NodeStorage& s) { s.begin_block(size_t{}); } {
+        if (list_size == 0) return;
+        
+        storage.begin_block(list_size);
+        node_type* current = head;
+        try {
+            while (current) {
+                prefetch_ahead(current);
+                node_type* moved = storage.create_in_block(std::move_if_noexcept(current->element));
+                moved->prev = current->prev;
+                moved->next = current->next;
+                if (moved->prev) {
+                    moved->prev->next = moved;
+                } else {
+                    head = moved;
+                }
+                if (moved->next) {
+                    moved->next->prev = moved;
+                } else {
+                    tail = moved;
+                }
+                destroy_node(current);
+                current = moved->next;
+            }
+        } catch (...) {
+            storage.abort_block();
+            throw;
+        }
+        storage.end_block();
+    }
+
+    void set_auto_compact(double churn_ratio) requires requires (NodeStorage& s) { s.set_compact_threshold(0.0); } {
+        storage.set_compact_threshold(churn_ratio);
+    }
+
+    void random_append(size_t length, T min = T{}, T max = T{100}) {
+        std::random_device rd;
+        std::mt19937 gen(rd());
+        
+        if constexpr (std::is_integral_v<T>) {
+            std::uniform_int_distribution<T> dis(min, max);
+            std::unordered_set<T> generated;
+            
+            for (size_t i = 0; i < length; ++i) {
+                T value;
+                do {
+                    value = dis(gen);
+                } while (generated.find(value) != generated.end());
+                
+                push_back(value);
+                generated.insert(value);
+            }
+        } else {
+            std::uniform_real_distribution<T> dis(min, max);
+            for (size_t i = 0; i < length; ++i) {
+                push_back(dis(gen));
+            }
+        }
+    }
+
+    // Moves all elements of other to the end of this list and leaves other empty. The two chains
+    // are joined in O(1) when other's nodes can change owner as they are; with a hash index on
+    // either list, different reverse() states or nodes tied to other's storage, they move one by one.
+    void splice(ListOperationsKit& other) {
+        if (&other == this || other.empty()) return;
+        if (empty()) reversed_order = other.reversed_order;
+        
+        if (value_index || other.value_index || reversed_order != other.reversed_order ||
+            !other.storage.transferable_all(storage)) {
+            while (node_type* theirs = other.first()) {
+                transfer_node(nullptr, other, theirs);
+            }
+            maybe_compact();
+            return;
+        }
+        
+        // Reversed lists are read tail to head, so other's chain goes physically in front.
+        node_type*& front_chain_tail = reversed_order ? other.tail : tail;
+        node_type*& back_chain_head = reversed_order ? head : other.head;
+        if (front_chain_tail) front_chain_tail->next = back_chain_head;
+        if (back_chain_head) back_chain_head->prev = front_chain_tail;
+        if (reversed_order) {
+            head = other.head;
+            if (!tail) tail = other.tail;
+        } else {
+            if (!head) head = other.head;
+            tail = other.tail;
+        }
+        list_size += other.list_size;
+        aggregate.absorb(other.aggregate);
+        
+        other.head = nullptr;
+        other.tail = nullptr;
+        other.list_size = 0;
+        other.reversed_order = false;
+    }
+
+    void splice(ListOperationsKit&& other) {
+        splice(other);
+    }
+
+    void concatenate(const ListOperationsKit& other) {
+        for (const auto& item : other) {
+            push_back(item);
+        }
+    }
+
+    void reverse() noexcept {
+        reversed_order = !reversed_order;
+    }
+
+    // Moves the first k elements to the back (the element at index k becomes the front); negative k
+    // rotates the other way. Closes the list into a ring and cuts it, so only the walk to index k
+    // is paid, and node_at takes that from the nearer end.
+    void rotate(std::ptrdiff_t k) noexcept {
+        if (list_size <= 1) return;
+        
+        const auto n = static_cast<std::ptrdiff_t>(list_size);
+        k %= n;
+        if (k < 0) k += n;
+        if (k == 0) return;
+        
+        node_type* new_front = node_at(static_cast<size_t>(k));
+        tail->next = head;
+        head->prev = tail;
+        if (reversed_order) {
+            tail = new_front;
+            head = new_front->next;
+        } else {
+            head = new_front;
+            tail = new_front->prev;
+        }
+        head->prev = nullptr;
+        tail->next = nullptr;
+    }
+
+    // Fisher-Yates over an array of node pointers, then relinks the nodes in the new order.
+    // Elements are never copied or moved, so iterators and references stay valid.
+    template<typename UniformRandomBitGenerator>
+    void shuffle(UniformRandomBitGenerator&& rng) {
+        if (list_size <= 1) return;
+        
+        std::vector<node_type*> nodes;
+        nodes.reserve(list_size);
+        for (node_type* current = head; current; current = current->next) {
+            nodes.push_back(current);
+        }
+        std::shuffle(nodes.begin(), nodes.end(), rng);
+        relink(nodes);
+    }
+
+    // The k elements that come first under comp (the k smallest by default), in comp order, as a
+    // new list. A bounded heap of k pointers is kept while streaming the list once: O(n log k),
+    // and only the k results are copied.
+    template<typename Compare = std::less<>>
+    ListOperationsKit top_k(size_t k, Compare comp = Compare()) const {
+        ListOperationsKit result;
+        if (k == 0) return result;
+        
+        auto worse_kept = [&comp](const T* a, const T* b) { return comp(*a, *b); };
+        std::vector<const T*> heap;
+        heap.reserve(std::min(k, list_size));
+        for (const auto& item : *this) {
+            if (heap.size() < k) {
+                heap.push_back(&item);
+                std::push_heap(heap.begin(), heap.end(), worse_kept);
+            } else if (comp(item, *heap.front())) {
+                std::pop_heap(heap.begin(), heap.end(), worse_kept);
+                heap.back() = &item;
+                std::push_heap(heap.begin(), heap.end(), worse_kept);
+            }
+        }
+        std::sort_heap(heap.begin(), heap.end(), worse_kept);
+        
+        for (const T* item : heap) {
+            result.push_back(*item);
+        }
+        return result;
+    }
+
+    // Like std::nth_element: relinks the nodes so that the element at index is the one a full sort
+    // would put there, with no element before it greater and none after it less. O(n) on average;
+    // elements are not moved, so references stay valid.
+    template<typename Compare = std::less<>>
+    reference nth_element(size_t index, Compare comp = Compare()) {
+        if (index >= list_size) throw std::out_of_range("Index out of bounds");
+        
+        std::vector<node_type*> nodes;
+        nodes.reserve(list_size);
+        for (node_type* current = first(); current; current = after(current)) {
+            nodes.push_back(current);
+        }
+        std::nth_element(nodes.begin(), nodes.begin() + index, nodes.end(),
+                         [&comp](const node_type* a, const node_type* b) { return comp(a->element, b->element); });
+        relink(nodes);
+        return nodes[index]->element;
+    }
+
+    // Stable partition in one pass: elements satisfying pred come first, both groups keep their
+    // relative order. Nodes are relinked, not copied. Returns an iterator to the first element of
+    // the second group.
+    template<typename Predicate>
+    iterator partition(Predicate pred) {
+        node_type* matched_head = nullptr;
+        node_type* matched_tail = nullptr;
+        node_type* rest_head = nullptr;
+        node_type* rest_tail = nullptr;
+        
+        node_type* current = first();
+        while (current) {
+            node_type* next = after(current);
+            const bool matched = pred(std::as_const(current->element));
+            node_type*& group_head = matched ? matched_head : rest_head;
+            node_type*& group_tail = matched ? matched_tail : rest_tail;
+            current->prev = group_tail;
+            current->next = nullptr;
+            if (group_tail) {
+                group_tail->next = current;
+            } else {
+                group_head = current;
+            }
+            group_tail = current;
+            current = next;
+        }
+        
+        if (matched_tail) {
+            matched_tail->next = rest_head;
+            if (rest_head) rest_head->prev = matched_tail;
+        }
+        head = matched_head ? matched_head : rest_head;
+        tail = rest_tail ? rest_tail : matched_tail;
+        reversed_order = false;
+        return iterator(rest_head, this);
+    }
+
+    void sort() {
+        if (list_size <= 1) return;
+        
+        if constexpr (RadixSortable<T>) {
+            if (list_size >= radix_sort_threshold) {
+                radix_sort(false);
+                return;
+            }
+        }
+        
+        std::vector<T> temp;
+        temp.reserve(list_size);
+
+        for (const auto& item : *this) {
+            temp.push_back(item);
+        }
+
+        std::sort(temp.begin(), temp.end());
+
+        auto it = begin();
+        for (auto& item : temp) {
+            *it = std::move(item);
+            ++it;
+        }
+    }
+
+    template<typename Compare>
+    void sort(Compare comp) {
+        if (list_size <= 1) return;
+        
+        std::vector<T> temp;
+        temp.reserve(list_size);
+
+        for (const auto& item : *this) {
+            temp.push_back(item);
+        }
+        
+        std::sort(temp.begin(), temp.end(), comp);
+
+        auto it = begin();
+        for (auto& item : temp) {
+            *it = std::move(item);
+            ++it;
+        }
+    }
+
+    void sort(bool descending) {
+        if constexpr (RadixSortable<T>) {
+            if (list_size >= radix_sort_threshold) {
+                radix_sort(descending);
+                return;
+            }
+        }
+        
+        if (descending) {
+            sort(std::greater<T>());
+        } else {
+            sort();
+        }
+    }
+
+    template<typename KeyFunction>
+    void sort_by_key(KeyFunction key_fn, bool descending = false) {
+        using key_type = std::remove_cvref_t<std::invoke_result_t<KeyFunction&, const T&>>;
+        static_assert(RadixSortable<key_type>, "sort_by_key requires an integral or IEEE floating-point key");
+        using encoded_type = typename RadixKey<key_type>::key_type;
+        
+        if (list_size <= 1) return;
+        
+        const encoded_type mask = descending ? encoded_type(~encoded_type(0)) : encoded_type(0);
+        std::vector<T> temp;
+        std::vector<std::pair<encoded_type, size_t>> order;
+        temp.reserve(list_size);
+        order.reserve(list_size);
+        for (auto& item : *this) {
+            order.emplace_back(encoded_type(RadixKey<key_type>::encode(std::invoke(key_fn, std::as_const(item))) ^ mask), temp.size());
+            temp.push_back(std::move(item));
+        }
+        
+        lsd_radix_sort(order, [](const auto& entry) { return entry.first; });
+        
+        auto it = begin();
+        for (const auto& entry : order) {
+            *it = std::move(temp[entry.second]);
+            ++it;
+        }
+    }
+
+    void swap(size_t index1, size_t index2) {
+        if (index1 >= list_size || index2 >= list_size) {
+            throw std::out_of_range("Index out of bounds");
+        }
+        
+        if (index1 == index2) return;
+        
+        T temp = get(index1);
+        set(index1, get(index2));
+        set(index2, temp);
+    }
+
+    void set(size_t index, const T& value) {
+        if (index >= list_size) throw std::out_of_range("Index out of bounds");
+        
+        node_type* current = node_at(index);
+        index_erase(current->element);
+        current->element = value;
+        index_insert(current->element);
+    }
+
+    void set(size_t index, T&& value) {
+        if (index >= list_size) throw std::out_of_range("Index out of bounds");
+        
+        node_type* current = node_at(index);
+        index_erase(current->element);
+        current->element = std::move(value);
+        index_insert(current->element);
+    }
+
+    T get(size_t index) const {
+        if (index >= list_size) throw std::out_of_range("Index out of bounds");
+        return node_at(index)->element;
+    }
+
+    T& operator[](size_t index) {
+        return node_at(index)->element;
+    }
+
+    const T& operator[](size_t index) const {
+        return node_at(index)->element;
+    }
+
+    T operator()(size_t index) const {
+        return get(index);
+    }
+
+    std::vector<std::reference_wrapper<T>> get_many(std::span<const size_t> indices) {
+        std::vector<std::reference_wrapper<T>> result;
+        result.reserve(indices.size());
+        for (node_type* node : nodes_at(indices)) {
+            result.emplace_back(node->element);
+        }
+        return result;
+    }
+
+    std::vector<std::reference_wrapper<const T>> get_many(std::span<const size_t> indices) const {
+        std::vector<std::reference_wrapper<const T>> result;
+        result.reserve(indices.size());
+        for (const node_type* node : nodes_at(indices)) {
+            result.emplace_back(node->element);
+        }
+        return result;
+    }
+
+    void get_many(std::span<const size_t> indices, std::span<T> out) const {
+        if (out.size() != indices.size()) throw std::invalid_argument("Index and value counts differ");
+        
+        std::vector<node_type*> nodes = nodes_at(indices);
+        for (size_t i = 0; i < nodes.size(); ++i) {
+            out[i] = nodes[i]->element;
+        }
+    }
+
+    void set_many(std::span<const size_t> indices, std::span<const T> values) {
+        if (values.size() != indices.size()) throw std::invalid_argument("Index and value counts differ");
+        
+        std::vector<node_type*> nodes = nodes_at(indices);
+        for (size_t i = 0; i < nodes.size(); ++i) {
+            index_erase(nodes[i]->element);
+            nodes[i]->element = values[i];
+            index_insert(nodes[i]->element);
+        }
+    }
+
+    // Indices refer to positions before the call; duplicates are removed once.
+    size_t remove_many(std::span<const size_t> indices) {
+        std::vector<size_t> sorted(indices.begin(), indices.end());
+        std::sort(sorted.begin(), sorted.end());
+        sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+        
+        std::vector<node_type*> nodes = nodes_at(sorted);
+        for (node_type* node : nodes) {
+            erase_node(node);
+        }
+        if (!nodes.empty()) maybe_compact();
+        return nodes.size();
+    }
+
+    // Each value goes in front of the element that was at indices[i] before the call
+    // (index == size() appends); values sharing an index keep their relative order.
+    void insert_many(std::span<const size_t> indices, std::span<const T> values) {
+        if (values.size() != indices.size()) throw std::invalid_argument("Index and value counts differ");
+        
+        std::vector<node_type*> positions = nodes_at(indices, true);
+        for (size_t i = 0; i < positions.size(); ++i) {
+            insert_node(positions[i], create_node(values[i]));
+        }
+        if (!positions.empty()) maybe_compact();
+    }
+
+    ListOperationsKit& operator=(const ListOperationsKit& rhs) {
+        if (this != &rhs) {
+            clear();
+            for (const auto& item : rhs) {
+                push_back(item);
+            }
+        }
+        return *this;
+    }
+
+    ListOperationsKit& operator=(ListOperationsKit&& rhs) noexcept(NodeStorage::nodes_follow_move) {
+        if (this != &rhs) {
+            value_index.reset();
+            clear();
+            take(rhs);
+        }
+        return *this;
+    }
+
+    ListOperationsKit& operator=(std::initializer_list<T> init) {
+        clear();
+        for (const auto& item : init) {
+            push_back(item);
+        }
+        return *this;
+    }
+
+    ListOperationsKit slice(size_t start, size_t end, size_t step = 1) const {
+        ListOperationsKit result;
+        if (start >= list_size || step == 0) return result;
+        
+        for (const auto& item : view_slice(start, end, step)) {
+            result.push_back(item);
+        }
+        
+        return result;
+    }
+
+    ListSliceView<iterator> view_slice(size_t start, size_t end, size_t step = 1) {
+        return ListSliceView<iterator>(begin(), list_size, start, end, step);
+    }
+
+    ListSliceView<const_iterator> view_slice(size_t start, size_t end, size_t step = 1) const {
+        return ListSliceView<const_iterator>(begin(), list_size, start, end, step);
+    }
+
+    auto reversed() { return std::views::reverse(*this); }
+    auto reversed() const { return std::views::reverse(*this); }
+
+    template<typename Predicate>
+    auto filtered(Predicate pred) { return std::views::filter(*this, std::move(pred)); }
+
+    template<typename Predicate>
+    auto filtered(Predicate pred) const { return std::views::filter(*this, std::move(pred)); }
+
+    template<typename Function>
+    auto transformed(Function f) { return std::views::transform(*this, std::move(f)); }
+
+    template<typename Function>
+    auto transformed(Function f) const { return std::views::transform(*this, std::move(f)); }
+
+    ListOperationsKit copy() const {
+        return ListOperationsKit(*this);
+    }
+
+    size_t count(const T& element) const {
+        if (value_index) return value_index->count(element);
+        
+        size_t cnt = 0;
+        const node_type* current = head;
+        while (current) {
+            prefetch_ahead(current);
+            if (current->element == element) {
+                ++cnt;
+            }
+            current = current->next;
+        }
+        return cnt;
+    }
+
+    // Same O(n) cost as find_index(), but throws std::out_of_range when element is absent.
+    size_t index(const T& element) const {
+        size_t idx = find_index(element);
+        if (idx == std::numeric_limits<size_t>::max()) {
+            throw std::out_of_range("Element not found in list");
+        }
+        return idx;
+    }
+
+    // O(n) scan to the first match. The hash index only stores counts, so it rejects missing values
+    // in O(1) but cannot locate present ones: positions shift with every insert/remove in front.
+    size_t find_index(const T& element) const {
+        if (value_index && value_index->count(element) == 0) {
+            return std::numeric_limits<size_t>::max();
+        }
+        
+        const node_type* current = first();
+        size_t idx = 0;
+        while (current) {
+            prefetch_after(current);
+            if (current->element == element) {
+                return idx;
+            }
+            current = after(current);
+            ++idx;
+        }
+        return std::numeric_limits<size_t>::max();
+    }
+
+    bool contains(const T& element) const {
+        if (value_index) return value_index->count(element) != 0;
+        return find_index(element) != std::numeric_limits<size_t>::max();
+    }
+
+    void print() const {
+        for (const auto& item : *this) {
+            std::cout << item << " ";
+        }
+        std::cout << std::endl;
+    }
+
+    void print_reverse() const {
+        for (const auto& item : reversed()) {
+            std::cout << item << " ";
+        }
+        std::cout << std::endl;
+    }
+
+    std::string to_string() const {
+        std::stringstream ss;
+        const node_type* current = first();
+        while (current) {
+            prefetch_after(current);
+            ss << current->element;
+            current = after(current);
+            if (current) {
+                ss << " ";
+            }
+        }
+        return ss.str();
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, const ListOperationsKit& list) {
+        for (const auto& item : list) {
+            os << item << " ";
+        }
+        return os;
+    }
+
+    bool operator==(const ListOperationsKit& other) const {
+        if (list_size != other.list_size) return false;
+        
+        const node_type* current1 = first();
+        const node_type* current2 = other.first();
+        
+        while (current1 && current2) {
+            prefetch_after(current1);
+            other.prefetch_after(current2);
+            if (current1->element != current2->element) return false;
+            current1 = after(current1);
+            current2 = other.after(current2);
+        }
+        
+        return true;
+    }
+
+    bool operator!=(const ListOperationsKit& other) const {
+        return !(*this == other);
+    }
+
+    bool operator<(const ListOperationsKit& other) const {
+        const node_type* current1 = first();
+        const node_type* current2 = other.first();
+        
+        while (current1 && current2) {
+            prefetch_after(current1);
+            other.prefetch_after(current2);
+            if (current1->element < current2->element) return true;
+            if (current2->element < current1->element) return false;
+            current1 = after(current1);
+            current2 = other.after(current2);
+        }
+        
+        return !current1 && current2;
+    }
+
+    bool operator<=(const ListOperationsKit& other) const {
+        return !(other < *this);
+    }
+
+    bool operator>(const ListOperationsKit& other) const {
+        return other < *this;
+    }
+
+    bool operator>=(const ListOperationsKit& other) const {
+        return !(*this < other);
+    }
+
+    size_t get_size() const { return list_size; }
+    size_t length() const { return list_size; }
+};
+
+template<typename T, size_t N = 16>
+using SmallListOperationsKit = ListOperationsKit<T, InlineNodeStorage<T, N>>;
+
+template<typename T>
+using CacheAlignedListOperationsKit = ListOperationsKit<T, HeapNodeStorage<T, cache_line_size>>;
+
+template<typename T>
+using PmrListOperationsKit = ListOperationsKit<T, PmrNodeStorage<T>>;
+
+template<typename T, template<typename> class... Policies>
+using AggregatingListOperationsKit = ListOperationsKit<T, HeapNodeStorage<T>, Aggregates<Policies<T>...>>;
+
+// Append-only collector for many producer threads. Each thread appends to its own shard; the
+// shard's mutex is only ever contended by drain(), so producers share neither a lock nor a cache
+// line. drain() splices the shards onto one ListOperationsKit in O(shards), each thread's elements
+// in their append order. With global_order every append also draws a ticket from one shared
+// counter, and drain() merges the shards by ticket in O(n log shards) without copying elements.
+template<typename T>
+class ShardedListOperationsKit {
+private:
+    struct alignas(cache_line_size) Shard {
+        std::mutex lock;
+        ListOperationsKit<T> items;
+        std::vector<uint64_t> tickets;
+    };
+
+    static inline std::atomic<uint64_t> next_instance_id{1};
+
+    const uint64_t instance_id;
+    const bool global_order;
+    alignas(cache_line_size) std::atomic<uint64_t> next_ticket;
+    std::mutex registry_lock;
+    std::vector<std::unique_ptr<Shard>> shards;
+    std::unordered_map<std::thread::id, Shard*> shard_of_thread;
+
+    // The calling thread's shard. A thread-local cache remembers the last collector used, so the
+    // registry lock is taken only on a thread's first append (or when it alternates collectors).
+    Shard& local_shard() {
+        struct Cached {
+            uint64_t owner = 0;
+            Shard* shard = nullptr;
+        };
+        thread_local Cached cached;
+        if (cached.owner == instance_id) return *cached.shard;
+        
+        std::lock_guard<std::mutex> guard(registry_lock);
+        Shard*& shard = shard_of_thread[std::this_thread::get_id()];
+        if (!shard) shard = shards.emplace_back(std::make_unique<Shard>()).get();
+        cached = {instance_id, shard};
+        return *shard;
+    }
+
+    template<typename... Args>
+    void append_to_local(Args&&... args) {
+        Shard& shard = local_shard();
+        std::lock_guard<std::mutex> guard(shard.lock);
+        shard.items.emplace_back(std::forward<Args>(args)...);
+        if (global_order) {
+            try {
+                shard.tickets.push_back(next_ticket.fetch_add(1, std::memory_order_relaxed));
+            } catch (...) {
+                shard.items.pop_back();
+                throw;
+            }
+        }
+    }
+
+    // Moves the shards' elements to result in ticket order. Tickets are drawn under the shard
+    // lock, so once every shard is locked no later append can carry a smaller ticket.
+    void merge_by_ticket(ListOperationsKit<T>& result) {
+        std::vector<std::unique_lock<std::mutex>> held;
+        held.reserve(shards.size());
+        std::vector<std::pair<uint64_t, size_t>> heads;
+        std::vector<size_t> position(shards.size(), 0);
+        for (size_t i = 0; i < shards.size(); ++i) {
+            held.emplace_back(shards[i]->lock);
+            if (!shards[i]->tickets.empty()) heads.emplace_back(shards[i]->tickets.front(), i);
+        }
+        
+        auto later = std::greater<std::pair<uint64_t, size_t>>();
+        std::make_heap(heads.begin(), heads.end(), later);
+        while (!heads.empty()) {
+            std::pop_heap(heads.begin(), heads.end(), later);
+            const size_t i = heads.back().second;
+            ListOperationsKit<T>& items = shards[i]->items;
+            result.transfer_node(nullptr, items, items.first());
+            if (++position[i] < shards[i]->tickets.size()) {
+                heads.back().first = shards[i]->tickets[position[i]];
+                std::push_heap(heads.begin(), heads.end(), later);
+            } else {
+                heads.pop_back();
+            }
+        }
+        for (const auto& shard : shards) {
+            shard->tickets.clear();
+        }
+    }
+
+public:
+    explicit ShardedListOperationsKit(bool global_order = false)
+        : instance_id(next_instance_id.fetch_add(1, std::memory_order_relaxed)), global_order(global_order), next_ticket(0) {}
+    ShardedListOperationsKit(const ShardedListOperationsKit&) = delete;
+    ShardedListOperationsKit& operator=(const ShardedListOperationsKit&) = delete;
+
+    void append(const T& element) { append_to_local(element); }
+    void append(T&& element) { append_to_local(std::move(element)); }
+
+    template<typename... Args>
+    void emplace_back(Args&&... args) {
+        append_to_local(std::forward<Args>(args)...);
+    }
+
+    // Takes everything appended so far. Appends racing with drain() land either in this result
+    // or in the next one.
+    ListOperationsKit<T> drain() {
+        ListOperationsKit<T> result;
+        std::lock_guard<std::mutex> guard(registry_lock);
+        if (global_order) {
+            merge_by_ticket(result);
+        } else {
+            for (const auto& shard : shards) {
+                std::lock_guard<std::mutex> shard_guard(shard->lock);
+                result.splice(shard->items);
+            }
+        }
+        return result;
+    }
+
+    // Copy of the current contents in drain() order; the shards keep their elements.
+    ListOperationsKit<T> collect() {
+        ListOperationsKit<T> result;
+        std::lock_guard<std::mutex> guard(registry_lock);
+        if (global_order) {
+            std::vector<std::pair<uint64_t, const T*>> ordered;
+            std::vector<std::unique_lock<std::mutex>> held;
+            for (const auto& shard : shards) {
+                held.emplace_back(shard->lock);
+                size_t i = 0;
+                for (const auto& item : shard->items) {
+                    ordered.emplace_back(shard->tickets[i++], &item);
+                }
+            }
+            std::sort(ordered.begin(), ordered.end(),
+                      [](const auto& a, const auto& b) { return a.first < b.first; });
+            for (const auto& entry : ordered) {
+                result.push_back(*entry.second);
+            }
+        } else {
+            for (const auto& shard : shards) {
+                std::lock_guard<std::mutex> shard_guard(shard->lock);
+                result.concatenate(shard->items);
+            }
+        }
+        return result;
+    }
+
+    size_t size() {
+        std::lock_guard<std::mutex> guard(registry_lock);
+        size_t total = 0;
+        for (const auto& shard : shards) {
+            std::lock_guard<std::mutex> shard_guard(shard->lock);
+            total += shard->items.size();
+        }
+        return total;
+    }
+
+    bool empty() { return size() == 0; }
+
+    size_t shard_count() {
+        std::lock_guard<std::mutex> guard(registry_lock);
+        return shards.size();
+    }
+
+    bool ordered() const noexcept { return global_order; }
+};
+
+template<typename T, typename NodeStorage = HeapNodeStorage<T>>
+class LinkedStack : public stack<T> {
+public:
+    using node_type = typename NodeStorage::node_type;
+
+private:
+    node_type* stack_top;
+    size_t stack_size;
+    [[no_unique_address]] NodeStorage storage;
+
+    void push_node(node_type* new_node) noexcept {
+        new_node->next = stack_top;
+        stack_top = new_node;
+        ++stack_size;
+    }
+
+public:
+    LinkedStack() : stack_top(nullptr), stack_size(0) {}
+    explicit LinkedStack(std::pmr::memory_resource* resource)
+        requires std::constructible_from<NodeStorage, std::pmr::memory_resource*>
+        : stack_top(nullptr), stack_size(0), storage(resource) {}
+    LinkedStack(const LinkedStack&) = delete;
+    LinkedStack& operator=(const LinkedStack&) = delete;
+
+    ~LinkedStack() {
+        if (releases_in_bulk(storage)) return;
+        while (stack_top) {
+            node_type* next = stack_top->next;
+            storage.destroy(stack_top);
+            stack_top = next;
+        }
+    }
+
+    bool empty() const override { return stack_size == 0; }
+    size_t size() const override { return stack_size; }
+
+    T& top() override {
+        if (empty()) throw std::runtime_error("Invalid operation on empty stack");
+        return stack_top->element;
+    }
+
+    const T& top() const override {
+        if (empty()) throw std::runtime_error("Invalid operation on empty stack");
+        return stack_top->element;
+    }
+
+    void pop() override {
+        if (empty()) throw std::runtime_error("Invalid operation on empty stack");
+        node_type* old_top = stack_top;
+        stack_top = stack_top->next;
+        storage.destroy(old_top);
+        --stack_size;
+    }
+
+    void push(const T& element) override {
+        push_node(storage.create(element));
+    }
+
+    void push(T&& element) override {
+        push_node(storage.create(std::move(element)));
+    }
+
+    template<typename... Args>
+    void emplace(Args&&... args) {
+        push_node(storage.create(std::in_place, std::forward<Args>(args)...));
+    }
+};
+
+template<typename T, typename NodeStorage = HeapNodeStorage<T>, typename Aggregate = NoAggregates>
+class LinkedQueue : public queue<T> {
+public:
+    using node_type = typename NodeStorage::node_type;
+
+private:
+    node_type* queue_front;
+    node_type* queue_back;
+    size_t queue_size;
+    [[no_unique_address]] NodeStorage storage;
+    [[no_unique_address]] Aggregate aggregate;
+
+    void push_node(node_type* new_node) {
+        if constexpr (!std::is_same_v<Aggregate, NoAggregates>) {
+            try {
+                aggregate.on_insert(new_node->element);
+            } catch (...) {
+                storage.destroy(new_node);
+                throw;
+            }
+        }
+        if (empty()) {
+            queue_front = new_node;
+        } else {
+            new_node->prev = queue_back;
+            queue_back->next = new_node;
+        }
+        queue_back = new_node;
+        ++queue_size;
+    }
+
+public:
+    LinkedQueue() : queue_front(nullptr), queue_back(nullptr), queue_size(0) {}
+    explicit LinkedQueue(std::pmr::memory_resource* resource)
+        requires std::constructible_from<NodeStorage, std::pmr::memory_resource*>
+        : queue_front(nullptr), queue_back(nullptr), queue_size(0), storage(resource) {}
+    LinkedQueue(const LinkedQueue&) = delete;
+    LinkedQueue& operator=(const LinkedQueue&) = delete;
+
+    ~LinkedQueue() {
+        if (releases_in_bulk(storage)) return;
+        while (queue_front) {
+            node_type* next = queue_front->next;
+            storage.destroy(queue_front);
+            queue_front = next;
+        }
+    }
+
+    bool empty() const override { return queue_size == 0; }
+    size_t size() const override { return queue_size; }
+
+    T& front() override {
+        if (empty()) throw std::runtime_error("Invalid operation on empty queue");
+        return queue_front->element;
+    }
+
+    const T& front() const override {
+        if (empty()) throw std::runtime_error("Invalid operation on empty queue");
+        return queue_front->element;
+    }
+
+    T& back() override {
+        if (empty()) throw std::runtime_error("Invalid operation on empty queue");
+        return queue_back->element;
+    }
+
+    const T& back() const override {
+        if (empty()) throw std::runtime_error("Invalid operation on empty queue");
+        return queue_back->element;
+    }
+
+    void pop() override {
+        if (empty()) throw std::runtime_error("Invalid operation on empty queue");
+        
+        node_type* old_front = queue_front;
+        queue_front = queue_front->next;
+        if (queue_front) {
+            queue_front->prev = nullptr;
+        } else {
+            queue_back = nullptr;
+        }
+        aggregate.on_erase(old_front->element);
+        storage.destroy(old_front);
+        --queue_size;
+    }
+
+    // Available when the Aggregate policy tracks them; with WindowMinMaxAggregate min() and max()
+    // are O(1) over the current window.
+    T sum() const requires requires (const Aggregate& policy) { policy.sum(); } {
+        return aggregate.sum();
+    }
+
+    const T& min() const requires requires (const Aggregate& policy, const LinkedQueue& queue) { policy.min(queue); } {
+        if (empty()) throw std::runtime_error("Invalid operation on empty queue");
+        return aggregate.min(*this);
+    }
+
+    const T& max() const requires requires (const Aggregate& policy, const LinkedQueue& queue) { policy.max(queue); } {
+        if (empty()) throw std::runtime_error("Invalid operation on empty queue");
+        return aggregate.max(*this);
+    }
+
+    void push(const T& element) override {
+        push_node(storage.create(element));
+    }
+
+    void push(T&& element) override {
+        push_node(storage.create(std::move(element)));
+    }
+
+    template<typename... Args>
+    void emplace(Args&&... args) {
+        push_node(storage.create(std::in_place, std::forward<Args>(args)...));
+    }
+};
+
+template<typename T>
+using PmrLinkedStack = LinkedStack<T, PmrNodeStorage<T>>;
+
+template<typename T>
+using PmrLinkedQueue = LinkedQueue<T, PmrNodeStorage<T>>;
+
+template<typename T, template<typename> class... Policies>
+using AggregatingLinkedQueue = LinkedQueue<T, HeapNodeStorage<T>, Aggregates<Policies<T>...>>;
+
+// Pairing heap node. Siblings form a doubly linked chain like DoublyChainNode; prev of the leftmost
+// child points to the parent, which is how cut() tells the two cases apart.
+template<typename T>
+struct PairingHeapNode {
+    PairingHeapNode* next;
+    PairingHeapNode* prev;
+    PairingHeapNode* child;
+    T element;
+
+    template<typename... Args>
+    explicit PairingHeapNode(std::in_place_t, Args&&... args)
+        : next(nullptr), prev(nullptr), child(nullptr), element(std::forward<Args>(args)...) {}
+};
+
+// Priority queue on a pairing heap: push and merge are O(1), pop is amortized O(log n), and the
+// handle returned by insert() allows decrease_key, update and erase of any element. As with
+// std::priority_queue, top() is the largest element under Compare (std::less by default); use
+// std::greater for a min-queue. Nodes come from a pool of doubling blocks with a free list, and
+// merge() adopts the other queue's blocks, so handles stay valid across merges.
+template<typename T, typename Compare = std::less<T>>
+class LinkedPriorityQueue : public priority_queue<T> {
+public:
+    using node_type = PairingHeapNode<T>;
+
+    class handle {
+    private:
+        node_type* node;
+
+        friend class LinkedPriorityQueue;
+
+        explicit handle(node_type* node) noexcept : node(node) {}
+
+    public:
+        handle() noexcept : node(nullptr) {}
+
+        explicit operator bool() const noexcept { return node != nullptr; }
+        const T& operator*() const noexcept { return node->element; }
+        const T* operator->() const noexcept { return &node->element; }
+
+        bool operator==(const handle& other) const noexcept { return node == other.node; }
+    };
+
+private:
+    union Slot {
+        Slot* next_free;
+        alignas(node_type) unsigned char bytes[sizeof(node_type)];
+    };
+
+    struct Block {
+        std::unique_ptr<Slot[]> slots;
+        size_t capacity;
+    };
+
+    static constexpr size_t first_block_capacity = 64;
+
+    node_type* root;
+    size_t heap_size;
+    [[no_unique_address]] Compare comp;
+    std::vector<Block> blocks;
+    size_t active_block;
+    size_t active_used;
+    Slot* free_slots;
+    Slot* free_tail;
+
+    Slot* allocate_slot() {
+        if (free_slots) {
+            Slot* slot = free_slots;
+            free_slots = slot->next_free;
+            return slot;
+        }
+        if (blocks.empty() || active_used == blocks[active_block].capacity) {
+            if (!blocks.empty() && active_block + 1 < blocks.size()) {
+                ++active_block;
+            } else {
+                const size_t capacity = blocks.empty() ? first_block_capacity : blocks.back().capacity * 2;
+                blocks.push_back(Block{std::make_unique<Slot[]>(capacity), capacity});
+                active_block = blocks.size() - 1;
+            }
+            active_used = 0;
+        }
+        return &blocks[active_block].slots[active_used++];
+    }
+
+    // free_tail is only meaningful while free_slots is non-null; it lets merge() splice in O(1).
+    void push_free(Slot* slot) noexcept {
+        if (!free_slots) free_tail = slot;
+        slot->next_free = free_slots;
+        free_slots = slot;
+    }
+
+    void release_slot(node_type* node) noexcept {
+        push_free(reinterpret_cast<Slot*>(node));
+    }
+
+    template<typename... Args>
+    node_type* create_node(Args&&... args) {
+        Slot* slot = allocate_slot();
+        try {
+            return ::new (static_cast<void*>(slot->bytes)) node_type(std::in_place, std::forward<Args>(args)...);
+        } catch (...) {
+            push_free(slot);
+            throw;
+        }
+    }
+
+    void destroy_node(node_type* node) noexcept {
+        node->~node_type();
+        release_slot(node);
+    }
+
+    // Links two detached trees; the loser becomes the leftmost child of the winner.
+    node_type* meld(node_type* a, node_type* b) noexcept {
+        if (!a) return b;
+        if (!b) return a;
+        if (comp(a->element, b->element)) std::swap(a, b);
+        b->prev = a;
+        b->next = a->child;
+        if (a->child) a->child->prev = b;
+        a->child = b;
+        return a;
+    }
+
+    // Two-pass pairing of a sibling chain: meld neighbours left to right, then fold the pairs
+    // right to left.
+    node_type* merge_pairs(node_type* first) noexcept {
+        node_type* paired = nullptr;
+        while (first) {
+            node_type* a = first;
+            node_type* b = a->next;
+            first = b ? b->next : nullptr;
+            a->next = a->prev = nullptr;
+            if (b) b->next = b->prev = nullptr;
+            node_type* melded = meld(a, b);
+            melded->next = paired;
+            paired = melded;
+        }
+        
+        node_type* result = nullptr;
+        while (paired) {
+            node_type* next = paired->next;
+            paired->next = nullptr;
+            result = meld(result, paired);
+            paired = next;
+        }
+        return result;
+    }
+
+    void cut(node_type* node) noexcept {
+        if (node->prev->child == node) {
+            node->prev->child = node->next;
+        } else {
+            node->prev->next = node->next;
+        }
+        if (node->next) node->next->prev = node->prev;
+        node->next = nullptr;
+        node->prev = nullptr;
+    }
+
+    // Removes node from the heap without destroying it; its children are re-melded.
+    void detach(node_type* node) noexcept {
+        node_type* children = node->child;
+        node->child = nullptr;
+        if (children) children->prev = nullptr;
+        if (node == root) {
+            root = merge_pairs(children);
+        } else {
+            cut(node);
+            root = meld(root, merge_pairs(children));
+        }
+    }
+
+    void destroy_all() noexcept {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            std::vector<node_type*> pending;
+            if (root) pending.push_back(root);
+            while (!pending.empty()) {
+                node_type* node = pending.back();
+                pending.pop_back();
+                if (node->next) pending.push_back(node->next);
+                if (node->child) pending.push_back(node->child);
+                node->~node_type();
+            }
+        }
+        root = nullptr;
+        heap_size = 0;
+    }
+
+    void check_not_empty() const {
+        if (empty()) throw std::runtime_error("Invalid operation on empty priority queue");
+    }
+
+public:
+    explicit LinkedPriorityQueue(const Compare& comp = Compare())
+        : root(nullptr), heap_size(0), comp(comp), active_block(0), active_used(0), free_slots(nullptr), free_tail(nullptr) {}
+    LinkedPriorityQueue(const LinkedPriorityQueue&) = delete;
+    LinkedPriorityQueue& operator=(const LinkedPriorityQueue&) = delete;
+
+    ~LinkedPriorityQueue() {
+        destroy_all();
+    }
+
+    bool empty() const override { return heap_size == 0; }
+    size_t size() const override { return heap_size; }
+
+    const T& top() const override {
+        check_not_empty();
+        return root->element;
+    }
+
+    void pop() override {
+        check_not_empty();
+        node_type* old_root = root;
+        detach(old_root);
+        destroy_node(old_root);
+        --heap_size;
+    }
+
+    void push(const T& element) override { insert(element); }
+    void push(T&& element) override { insert(std::move(element)); }
+
+    handle insert(const T& element) { return emplace(element); }
+    handle insert(T&& element) { return emplace(std::move(element)); }
+
+    template<typename... Args>
+    handle emplace(Args&&... args) {
+        node_type* node = create_node(std::forward<Args>(args)...);
+        root = meld(root, node);
+        ++heap_size;
+        return handle(node);
+    }
+
+    // Moves the element towards the top: value must not rank below the current one under Compare
+    // (with std::greater, not be larger). The node's subtree is cut and melded with the root.
+    void decrease_key(handle position, const T& value) {
+        node_type* node = position.node;
+        if (comp(value, node->element)) throw std::invalid_argument("New key has lower priority than the current one");
+        node->element = value;
+        if (node != root) {
+            cut(node);
+            root = meld(root, node);
+        }
+    }
+
+    // Changes the element in either direction; a lower priority reinserts the node, O(log n) amortized.
+    void update(handle position, const T& value) {
+        node_type* node = position.node;
+        if (!comp(value, node->element)) {
+            decrease_key(position, value);
+            return;
+        }
+        detach(node);
+        node->element = value;
+        root = meld(root, node);
+    }
+
+    void erase(handle position) {
+        node_type* node = position.node;
+        detach(node);
+        destroy_node(node);
+        --heap_size;
+    }
+
+    // Melds other into this queue in O(1) (plus moving its block list) and leaves other empty.
+    // Handles into other now refer to elements of this queue.
+    void merge(LinkedPriorityQueue& other) {
+        if (&other == this || other.empty()) return;
+        
+        root = meld(root, other.root);
+        heap_size += other.heap_size;
+        
+        // Adopted blocks go in front of the active one so the bump allocator never hands out their
+        // slots again; only their free list is reused.
+        const bool had_blocks = !blocks.empty();
+        blocks.insert(blocks.begin(), std::make_move_iterator(other.blocks.begin()), std::make_move_iterator(other.blocks.end()));
+        if (had_blocks) {
+            active_block += other.blocks.size();
+        } else {
+            active_block = blocks.size() - 1;
+            active_used = blocks.back().capacity;
+        }
+        if (other.free_slots) {
+            if (!free_slots) free_tail = other.free_tail;
+            other.free_tail->next_free = free_slots;
+            free_slots = other.free_slots;
+        }
+        
+        other.blocks.clear();
+        other.root = nullptr;
+        other.heap_size = 0;
+        other.active_block = 0;
+        other.active_used = 0;
+        other.free_slots = nullptr;
+        other.free_tail = nullptr;
+    }
+
+    void merge(LinkedPriorityQueue&& other) {
+        merge(other);
+    }
+
+    void clear() noexcept {
+        destroy_all();
+        free_slots = nullptr;
+        free_tail = nullptr;
+        active_block = 0;
+        active_used = 0;
+    }
+};
+
+// Chase-Lev work-stealing deque (in the C11 formulation of Le et al., PPoPP 2013). The owning
+// thread pushes and pops at the bottom through the stack<T> interface; any thread may steal()
+// from the top. Elements are boxed so that every slot is a single atomic pointer, and the ring
+// grows without locking: the owner publishes a doubled copy and retires the old ring, which stays
+// readable by in-flight thieves until the deque is destroyed. size(), empty() and top() are exact
+// only while no thief runs concurrently.
+template<typename T>
+class WorkStealingDeque : public stack<T> {
+private:
+    struct RingBuffer {
+        int64_t capacity;
+        std::unique_ptr<std::atomic<T*>[]> slots;
+        
+        explicit RingBuffer(int64_t capacity) 
+            : capacity(capacity), slots(new std::atomic<T*>[static_cast<size_t>(capacity)]) {}
+        
+        T* load(int64_t index) const noexcept {
+            return slots[index & (capacity - 1)].load(std::memory_order_relaxed);
+        }
+        
+        void store(int64_t index, T* element) noexcept {
+            slots[index & (capacity - 1)].store(element, std::memory_order_relaxed);
+        }
+    };
+
+    alignas(cache_line_size) std::atomic<int64_t> top_index;
+    alignas(cache_line_size) std::atomic<int64_t> bottom_index;
+    std::atomic<RingBuffer*> ring;
+    std::vector<std::unique_ptr<RingBuffer>> rings;
+
+    RingBuffer* grow(RingBuffer* old_ring, int64_t bottom, int64_t top) {
+        auto bigger = std::make_unique<RingBuffer>(old_ring->capacity * 2);
+        for (int64_t i = top; i < bottom; ++i) {
+            bigger->store(i, old_ring->load(i));
+        }
+        rings.push_back(std::move(bigger));
+        ring.store(rings.back().get(), std::memory_order_release);
+        return rings.back().get();
+    }
+
+    void push_box(std::unique_ptr<T> element) {
+        int64_t bottom = bottom_index.load(std::memory_order_relaxed);
+        int64_t top = top_index.load(std::memory_order_acquire);
+        RingBuffer* current = ring.load(std::memory_order_relaxed);
+        if (bottom - top > current->capacity - 1) {
+            current = grow(current, bottom, top);
+        }
+        current->store(bottom, element.release());
+        bottom_index.store(bottom + 1, std::memory_order_release);
+    }
+
+    T* take_box() noexcept {
+        int64_t bottom = bottom_index.load(std::memory_order_relaxed) - 1;
+        RingBuffer* current = ring.load(std::memory_order_relaxed);
+        bottom_index.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t top = top_index.load(std::memory_order_relaxed);
+        
+        if (top > bottom) {
+            bottom_index.store(bottom + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        T* element = current->load(bottom);
+        if (top == bottom) {
+            if (!top_index.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                                   std::memory_order_relaxed)) {
+                element = nullptr;
+            }
+            bottom_index.store(bottom + 1, std::memory_order_relaxed);
+        }
+        return element;
+    }
+
+    T* steal_box() noexcept {
+        int64_t top = top_index.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t bottom = bottom_index.load(std::memory_order_acquire);
+        if (top >= bottom) return nullptr;
+        
+        T* element = ring.load(std::memory_order_acquire)->load(top);
+        if (!top_index.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                               std::memory_order_relaxed)) {
+            return nullptr;
+        }
+        return element;
+    }
+
+    static std::optional<T> unbox(T* element) {
+        if (!element) return std::nullopt;
+        std::unique_ptr<T> owned(element);
+        return std::optional<T>(std::move(*owned));
+    }
+
+public:
+    explicit WorkStealingDeque(size_t initial_capacity = 64) : top_index(0), bottom_index(0) {
+        rings.push_back(std::make_unique<RingBuffer>(
+            static_cast<int64_t>(std::bit_ceil(std::max<size_t>(initial_capacity, 2)))));
+        ring.store(rings.back().get(), std::memory_order_relaxed);
+    }
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+    ~WorkStealingDeque() {
+        RingBuffer* current = ring.load(std::memory_order_relaxed);
+        int64_t bottom = bottom_index.load(std::memory_order_relaxed);
+        for (int64_t i = top_index.load(std::memory_order_relaxed); i < bottom; ++i) {
+            delete current->load(i);
+        }
+    }
+
+    bool empty() const override { return size() == 0; }
+
+    size_t size() const override {
+        int64_t bottom = bottom_index.load(std::memory_order_relaxed);
+        int64_t top = top_index.load(std::memory_order_relaxed);
+        return bottom > top ? static_cast<size_t>(bottom - top) : 0;
+    }
+
+    T& top() override {
+        if (empty()) throw std::runtime_error("Invalid operation on empty stack");
+        return *ring.load(std::memory_order_relaxed)->load(bottom_index.load(std::memory_order_relaxed) - 1);
+    }
+
+    const T& top() const override {
+        if (empty()) throw std::runtime_error("Invalid operation on empty stack");
+        return *ring.load(std::memory_order_relaxed)->load(bottom_index.load(std::memory_order_relaxed) - 1);
+    }
+
+    void pop() override {
+        T* element = take_box();
+        if (!element) throw std::runtime_error("Invalid operation on empty stack");
+        delete element;
+    }
+
+    void push(const T& element) override {
+        push_box(std::make_unique<T>(element));
+    }
+
+    void push(T&& element) override {
+        push_box(std::make_unique<T>(std::move(element)));
+    }
+
+    template<typename... Args>
+    void emplace(Args&&... args) {
+        push_box(std::make_unique<T>(std::forward<Args>(args)...));
+    }
+
+    // Owner only: removes the most recently pushed element, or returns nullopt when empty.
+    std::optional<T> try_pop() {
+        return unbox(take_box());
+    }
+
+    // Any thread: removes the oldest element. Returns nullopt when empty or when the element
+    // was lost to a concurrent pop or steal.
+    std::optional<T> steal() {
+        return unbox(steal_box());
+    }
+};
+
+// Fixed-size executor with one WorkStealingDeque per worker. Tasks spawned from inside the pool go
+// to the spawning worker's own deque; idle workers steal from the others, so the only lock left is
+// around the queue for submissions from outside threads and the idle wait.
+class WorkStealingThreadPool {
+private:
+    using Task = std::function<void()>;
+
+    struct Worker {
+        WorkStealingDeque<Task> deque;
+        std::minstd_rand victims;
+        std::thread thread;
+        
+        explicit Worker(size_t index) : victims(static_cast<std::minstd_rand::result_type>(index + 1)) {}
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    LinkedQueue<Task> injected;
+    std::atomic<size_t> injected_size;
+    std::atomic<size_t> queued;
+    std::atomic<size_t> sleepers;
+    std::atomic<bool> stopping;
+    std::mutex mutex;
+    std::condition_variable wake;
+
+    inline static thread_local WorkStealingThreadPool* current_pool = nullptr;
+    inline static thread_local size_t current_worker = 0;
+
+    void enqueue(Task task) {
+        queued.fetch_add(1);
+        if (current_pool == this) {
+            workers[current_worker]->deque.push(std::move(task));
+        } else {
+            std::lock_guard<std::mutex> lock(mutex);
+            injected.push(std::move(task));
+            injected_size.fetch_add(1);
+        }
+        if (sleepers.load() > 0) {
+            std::lock_guard<std::mutex> lock(mutex);
+            wake.notify_one();
+        }
+    }
+
+    std::optional<Task> find_task(size_t self) {
+        Worker& worker = *workers[self];
+        std::optional<Task> task = worker.deque.try_pop();
+        
+        if (!task && injected_size.load() > 0) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!injected.empty()) {
+                task = std::move(injected.front());
+                injected.pop();
+                injected_size.fetch_sub(1);
+            }
+        }
+        
+        for (size_t attempt = 0; !task && attempt < workers.size(); ++attempt) {
+            size_t victim = worker.victims() % workers.size();
+            if (victim != self) {
+                task = workers[victim]->deque.steal();
+            }
+        }
+        
+        if (task) queued.fetch_sub(1);
+        return task;
+    }
+
+    void run_worker(size_t index) {
+        current_pool = this;
+        current_worker = index;
+        
+        while (true) {
+            if (std::optional<Task> task = find_task(index)) {
+                (*task)();
+                continue;
+            }
+            
+            std::unique_lock<std::mutex> lock(mutex);
+            sleepers.fetch_add(1);
+            wake.wait(lock, [this] { return stopping.load() || queued.load() > 0; });
+            sleepers.fetch_sub(1);
+            if (stopping.load() && queued.load() == 0) return;
+        }
+    }
+
+    void help_until(const std::atomic<bool>& done) {
+        while (!done.load(std::memory_order_acquire)) {
+            if (std::optional<Task> task = find_task(current_worker)) {
+                (*task)();
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+public:
+    explicit WorkStealingThreadPool(size_t thread_count = std::thread::hardware_concurrency())
+        : injected_size(0), queued(0), sleepers(0), stopping(false) {
+        thread_count = std::max<size_t>(thread_count, 1);
+        for (size_t i = 0; i < thread_count; ++i) {
+            workers.push_back(std::make_unique<Worker>(i));
+        }
+        for (size_t i = 0; i < thread_count; ++i) {
+            workers[i]->thread = std::thread([this, i] { run_worker(i); });
+        }
+    }
+    WorkStealingThreadPool(const WorkStealingThreadPool&) = delete;
+    WorkStealingThreadPool& operator=(const WorkStealingThreadPool&) = delete;
+
+    // Runs every task that is still queued, then joins the workers.
+    ~WorkStealingThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping.store(true);
+        }
+        wake.notify_all();
+        for (auto& worker : workers) {
+            worker->thread.join();
+        }
+    }
+
+    size_t thread_count() const { return workers.size(); }
+
+    // Fire-and-forget; the task must not throw.
+    template<typename Function>
+    void post(Function&& function) {
+        enqueue(Task(std::forward<Function>(function)));
+    }
+
+    // Blocking on the returned future from inside a pool task only waits; use invoke() there.
+    template<typename Function>
+    auto submit(Function&& function) -> std::future<std::invoke_result_t<std::decay_t<Function>&>> {
+        using Result = std::invoke_result_t<std::decay_t<Function>&>;
+        auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<Function>(function));
+        std::future<Result> result = task->get_future();
+        enqueue([task] { (*task)(); });
+        return result;
+    }
+
+    // Fork-join: makes second available for stealing, runs first inline, then runs queued or
+    // stolen work until second has finished. Called from outside the pool, the pair is submitted
+    // as one task and the caller blocks. An exception from either side is rethrown after both ran.
+    template<typename First, typename Second>
+    void invoke(First&& first, Second&& second) {
+        if (current_pool != this) {
+            submit([&] { invoke(first, second); }).get();
+            return;
+        }
+        
+        std::atomic<bool> done(false);
+        std::exception_ptr second_error;
+        enqueue([&] {
+            try {
+                second();
+            } catch (...) {
+                second_error = std::current_exception();
+            }
+            done.store(true, std::memory_order_release);
+        });
+        
+        std::exception_ptr first_error;
+        try {
+            first();
+        } catch (...) {
+            first_error = std::current_exception();
+        }
+        help_until(done);
+        
+        if (first_error) std::rethrow_exception(first_error);
+        if (second_error) std::rethrow_exception(second_error);
+    }
+};
+
+class coroutine_scheduler {
+public:
+    virtual ~coroutine_scheduler() = default;
+
+    virtual void schedule(std::coroutine_handle<> handle) = 0;
+};
+
+// Fire-and-forget coroutine. It starts suspended and runs once handed to a scheduler via spawn();
+// the frame frees itself when the body returns. An escaping exception calls std::terminate.
+class AsyncTask {
+public:
+    struct promise_type {
+        AsyncTask get_return_object() noexcept {
+            return AsyncTask(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+        std::suspend_always initial_suspend() const noexcept { return {}; }
+        std::suspend_never final_suspend() const noexcept { return {}; }
+        void return_void() const noexcept {}
+        void unhandled_exception() const noexcept { std::terminate(); }
+    };
+
+private:
+    std::coroutine_handle<promise_type> handle;
+
+    explicit AsyncTask(std::coroutine_handle<promise_type> handle) noexcept : handle(handle) {}
+
+public:
+    AsyncTask(AsyncTask&& other) noexcept : handle(std::exchange(other.handle, nullptr)) {}
+    AsyncTask(const AsyncTask&) = delete;
+    AsyncTask& operator=(const AsyncTask&) = delete;
+
+    ~AsyncTask() {
+        if (handle) handle.destroy();
+    }
+
+    void spawn(coroutine_scheduler& scheduler) {
+        scheduler.schedule(std::exchange(handle, nullptr));
+    }
+};
+
+// Resumes coroutines on the thread that calls run(); schedule() must be called from that thread too.
+class SingleThreadedScheduler : public coroutine_scheduler {
+private:
+    LinkedQueue<std::coroutine_handle<>> ready;
+
+public:
+    void schedule(std::coroutine_handle<> handle) override {
+        ready.push(handle);
+    }
+
+    // Resumes ready coroutines until none is left, returns how many were resumed.
+    size_t run() {
+        size_t resumed = 0;
+        while (!ready.empty()) {
+            std::coroutine_handle<> handle = ready.front();
+            ready.pop();
+            handle.resume();
+            ++resumed;
+        }
+        return resumed;
+    }
+};
+
+// Resumes coroutines on a WorkStealingThreadPool; a coroutine woken from a worker is resumed
+// on that worker's own deque first.
+class MultiThreadedScheduler : public coroutine_scheduler {
+private:
+    WorkStealingThreadPool pool;
+
+public:
+    explicit MultiThreadedScheduler(size_t thread_count = std::thread::hardware_concurrency())
+        : pool(thread_count) {}
+
+    void schedule(std::coroutine_handle<> handle) override {
+        pool.post([handle] { handle.resume(); });
+    }
+
+    size_t thread_count() const { return pool.thread_count(); }
+};
+
+// FIFO queue whose consumers co_await pop() instead of blocking a thread, so an idle consumer
+// costs only its coroutine frame. With a capacity, co_await push() suspends producers while the
+// queue is full (capacity 0 hands every value directly to a consumer). Blocked coroutines are
+// resumed through the scheduler, or inline on the unblocking thread when there is none.
+// Coroutines must not be destroyed while suspended on the queue; close() releases them.
+template<typename T>
+class AsyncLinkedQueue {
+private:
+    struct Waiter {
+        std::coroutine_handle<> handle;
+        Waiter* next = nullptr;
+        std::optional<T> value;
+        bool accepted = false;
+    };
+
+    struct WaiterList {
+        Waiter* first = nullptr;
+        Waiter* last = nullptr;
+        
+        void push_back(Waiter* waiter) noexcept {
+            waiter->next = nullptr;
+            if (last) {
+                last->next = waiter;
+            } else {
+                first = waiter;
+            }
+            last = waiter;
+        }
+        
+        Waiter* pop_front() noexcept {
+            Waiter* waiter = first;
+            if (waiter) {
+                first = waiter->next;
+                if (!first) last = nullptr;
+            }
+            return waiter;
+        }
+    };
+
+    mutable std::mutex mutex;
+    LinkedQueue<T> items;
+    WaiterList consumers;
+    WaiterList producers;
+    size_t queue_capacity;
+    bool closed;
+    coroutine_scheduler* scheduler;
+
+    void resume(Waiter* waiter) {
+        if (scheduler) {
+            scheduler->schedule(waiter->handle);
+        } else {
+            waiter->handle.resume();
+        }
+    }
+
+    // Lock held. Takes the oldest value and lets the oldest blocked producer refill the queue.
+    std::optional<T> take_locked(std::vector<Waiter*>& released) {
+        std::optional<T> value;
+        if (!items.empty()) {
+            value.emplace(std::move(items.front()));
+            items.pop();
+            if (Waiter* producer = producers.pop_front()) {
+                items.push(std::move(*producer->value));
+                producer->accepted = true;
+                released.push_back(producer);
+            }
+        } else if (Waiter* producer = producers.pop_front()) {
+            value = std::move(producer->value);
+            producer->accepted = true;
+            released.push_back(producer);
+        }
+        return value;
+    }
+
+    // Lock held. Hands the value to a waiting consumer or stores it if there is room.
+    bool offer_locked(std::optional<T>& value, Waiter*& consumer) {
+        if ((consumer = consumers.pop_front())) {
+            consumer->value = std::move(value);
+            return true;
+        }
+        if (items.size() < queue_capacity) {
+            items.push(std::move(*value));
+            return true;
+        }
+        return false;
+    }
+
+    void resume_all(const std::vector<Waiter*>& released) {
+        for (Waiter* waiter : released) {
+            resume(waiter);
+        }
+    }
+
+public:
+    class PopAwaiter {
+    private:
+        AsyncLinkedQueue& queue;
+        Waiter waiter;
+
+    public:
+        explicit PopAwaiter(AsyncLinkedQueue& queue) : queue(queue) {}
+
+        bool await_ready() const noexcept { return false; }
+
+        bool await_suspend(std::coroutine_handle<> handle) {
+            std::vector<Waiter*> released;
+            {
+                std::lock_guard<std::mutex> lock(queue.mutex);
+                waiter.value = queue.take_locked(released);
+                if (!waiter.value && !queue.closed) {
+                    waiter.handle = handle;
+                    queue.consumers.push_back(&waiter);
+                    return true;
+                }
+            }
+            queue.resume_all(released);
+            return false;
+        }
+
+        // nullopt once the queue is closed and drained.
+        std::optional<T> await_resume() { return std::move(waiter.value); }
+    };
+
+    class PopBatchAwaiter {
+    private:
+        AsyncLinkedQueue& queue;
+        size_t limit;
+        Waiter waiter;
+        std::vector<T> batch;
+
+        void drain() {
+            std::vector<Waiter*> released;
+            {
+                std::lock_guard<std::mutex> lock(queue.mutex);
+                while (batch.size() < limit) {
+                    std::optional<T> value = queue.take_locked(released);
+                    if (!value) break;
+                    batch.push_back(std::move(*value));
+                }
+            }
+            queue.resume_all(released);
+        }
+
+    public:
+        PopBatchAwaiter(AsyncLinkedQueue& queue, size_t limit) : queue(queue), limit(limit) {}
+
+        bool await_ready() const noexcept { return limit == 0; }
+
+        bool await_suspend(std::coroutine_handle<> handle) {
+            std::vector<Waiter*> released;
+            {
+                std::lock_guard<std::mutex> lock(queue.mutex);
+                while (batch.size() < limit) {
+                    std::optional<T> value = queue.take_locked(released);
+                    if (!value) break;
+                    batch.push_back(std::move(*value));
+                }
+                if (batch.empty() && !queue.closed) {
+                    waiter.handle = handle;
+                    queue.consumers.push_back(&waiter);
+                    return true;
+                }
+            }
+            queue.resume_all(released);
+            return false;
+        }
+
+        // Between 1 and limit values; empty once the queue is closed and drained.
+        std::vector<T> await_resume() {
+            if (waiter.value) {
+                batch.push_back(std::move(*waiter.value));
+                waiter.value.reset();
+                drain();
+            }
+            return std::move(batch);
+        }
+    };
+
+    class PushAwaiter {
+    private:
+        AsyncLinkedQueue& queue;
+        Waiter waiter;
+
+    public:
+        PushAwaiter(AsyncLinkedQueue& queue, T value) : queue(queue) {
+            waiter.value.emplace(std::move(value));
+        }
+
+        bool await_ready() const noexcept { return false; }
+
+        bool await_suspend(std::coroutine_handle<> handle) {
+            Waiter* consumer = nullptr;
+            {
+                std::lock_guard<std::mutex> lock(queue.mutex);
+                if (queue.closed) return false;
+                waiter.accepted = queue.offer_locked(waiter.value, consumer);
+                if (!waiter.accepted) {
+                    waiter.handle = handle;
+                    queue.producers.push_back(&waiter);
+                    return true;
+                }
+            }
+            if (consumer) queue.resume(consumer);
+            return false;
+        }
+
+        // false if the queue was closed before the value could be queued.
+        bool await_resume() const noexcept { return waiter.accepted; }
+    };
+
+    explicit AsyncLinkedQueue(size_t capacity = std::numeric_limits<size_t>::max(),
+                              coroutine_scheduler* scheduler = nullptr)
+        : queue_capacity(capacity), closed(false), scheduler(scheduler) {}
+    AsyncLinkedQueue(const AsyncLinkedQueue&) = delete;
+    AsyncLinkedQueue& operator=(const AsyncLinkedQueue&) = delete;
+
+    PopAwaiter pop() { return PopAwaiter(*this); }
+    PopBatchAwaiter pop_up_to(size_t limit) { return PopBatchAwaiter(*this, limit); }
+    PushAwaiter push(T value) { return PushAwaiter(*this, std::move(value)); }
+
+    bool try_push(T value) {
+        std::optional<T> slot(std::move(value));
+        Waiter* consumer = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (closed || !offer_locked(slot, consumer)) return false;
+        }
+        if (consumer) resume(consumer);
+        return true;
+    }
+
+    std::optional<T> try_pop() {
+        std::vector<Waiter*> released;
+        std::optional<T> value;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            value = take_locked(released);
+        }
+        resume_all(released);
+        return value;
+    }
+
+    // Rejects further pushes and resumes every blocked coroutine: consumers get nullopt once the
+    // remaining values are drained, blocked producers get false.
+    void close() {
+        std::vector<Waiter*> released;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            closed = true;
+            while (Waiter* consumer = consumers.pop_front()) {
+                released.push_back(consumer);
+            }
+            while (Waiter* producer = producers.pop_front()) {
+                released.push_back(producer);
+            }
+        }
+        resume_all(released);
+    }
+
+    bool is_closed() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return closed;
+    }
+
+    size_t size() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return items.size();
+    }
+
+    bool empty() const { return size() == 0; }
+    size_t capacity() const { return queue_capacity; }
+};
+
+// Process-wide epoch-based reclamation for the concurrent lists below. Readers pin the current
+// epoch with an EpochGuard; a node unlinked while the global epoch is e is freed once the epoch
+// has reached e + 2, at which point no guard that could still see the node is alive.
+class EpochReclaimer {
+private:
+    struct Retired {
+        void* pointer;
+        void (*deleter)(void*);
+        uint64_t epoch;
+    };
+
+    struct ThreadRecord {
+        std::atomic<uint64_t> pinned{0};
+        std::atomic<bool> in_use{true};
+        ThreadRecord* next = nullptr;
+        size_t nesting = 0;
+        size_t retired_since_scan = 0;
+        std::array<std::vector<Retired>, 3> retired;
+    };
+
+    // Returns the record to the pool when its thread exits; its retired nodes are adopted by
+    // whichever thread picks it up next.
+    struct RecordOwner {
+        ThreadRecord* record = nullptr;
+        
+        ~RecordOwner() {
+            if (record) record->in_use.store(false, std::memory_order_release);
+        }
+    };
+
+    static constexpr size_t scan_interval = 64;
+
+    std::atomic<uint64_t> global_epoch{3};
+    std::atomic<ThreadRecord*> records{nullptr};
+
+    EpochReclaimer() = default;
+
+    ThreadRecord& local_record() {
+        thread_local RecordOwner owner;
+        if (owner.record) return *owner.record;
+        
+        for (ThreadRecord* record = records.load(std::memory_order_acquire); record; record = record->next) {
+            bool expected = false;
+            if (!record->in_use.load(std::memory_order_relaxed) &&
+                record->in_use.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+                owner.record = record;
+                return *record;
+            }
+        }
+        
+        auto* record = new ThreadRecord();
+        record->next = records.load(std::memory_order_relaxed);
+        while (!records.compare_exchange_weak(record->next, record, std::memory_order_release,
+                                              std::memory_order_relaxed)) {
+        }
+        owner.record = record;
+        return *record;
+    }
+
+    void try_advance(uint64_t epoch) {
+        for (ThreadRecord* record = records.load(std::memory_order_acquire); record; record = record->next) {
+            uint64_t pinned = record->pinned.load(std::memory_order_seq_cst);
+            if (pinned != 0 && pinned != epoch) return;
+        }
+        global_epoch.compare_exchange_strong(epoch, epoch + 1, std::memory_order_acq_rel);
+    }
+
+    static void release(std::vector<Retired>& retired, uint64_t safe_epoch) {
+        auto kept = std::partition(retired.begin(), retired.end(),
+                                   [safe_epoch](const Retired& r) { return r.epoch > safe_epoch; });
+        for (auto it = kept; it != retired.end(); ++it) {
+            it->deleter(it->pointer);
+        }
+        retired.erase(kept, retired.end());
+    }
+
+public:
+    EpochReclaimer(const EpochReclaimer&) = delete;
+    EpochReclaimer& operator=(const EpochReclaimer&) = delete;
+
+    ~EpochReclaimer() {
+        ThreadRecord* record = records.load(std::memory_order_acquire);
+        while (record) {
+            ThreadRecord* next = record->next;
+            for (auto& bucket : record->retired) {
+                release(bucket, std::numeric_limits<uint64_t>::max());
+            }
+            delete record;
+            record = next;
+        }
+    }
+
+    static EpochReclaimer& instance() {
+        static EpochReclaimer reclaimer;
+        return reclaimer;
+    }
+
+    void enter() {
+        ThreadRecord& record = local_record();
+        if (record.nesting++ > 0) return;
+        
+        uint64_t epoch = global_epoch.load(std::memory_order_acquire);
+        record.pinned.store(epoch, std::memory_order_seq_cst);
+        release(record.retired[(epoch + 1) % 3], epoch - 2);
+    }
+
+    void exit() {
+        ThreadRecord& record = local_record();
+        if (--record.nesting == 0) {
+            record.pinned.store(0, std::memory_order_release);
+        }
+    }
+
+    // Must be called inside a guard, after the node has been unlinked.
+    template<typename Node>
+    void retire(Node* node) {
+        ThreadRecord& record = local_record();
+        uint64_t epoch = global_epoch.load(std::memory_order_acquire);
+        record.retired[epoch % 3].push_back(
+            Retired{node, [](void* pointer) { delete static_cast<Node*>(pointer); }, epoch});
+        if (++record.retired_since_scan >= scan_interval) {
+            record.retired_since_scan = 0;
+            try_advance(epoch);
+        }
+    }
+};
+
+class EpochGuard {
+public:
+    EpochGuard() { EpochReclaimer::instance().enter(); }
+    ~EpochGuard() { EpochReclaimer::instance().exit(); }
+    EpochGuard(const EpochGuard&) = delete;
+    EpochGuard& operator=(const EpochGuard&) = delete;
+};
+
+// Harris's lock-free sorted set, with Michael's refinement that traversals unlink logically
+// deleted nodes as they pass them. The low bit of a next pointer marks its node as deleted;
+// insert and erase are lock-free, contains is wait-free and never writes. Unlinked nodes are
+// reclaimed through EpochReclaimer.
+template<typename T, typename Compare = std::less<T>>
+class LockFreeSortedList {
+private:
+    struct Node {
+        T element;
+        std::atomic<uintptr_t> next;
+        
+        template<typename... Args>
+        explicit Node(std::in_place_t, Args&&... args) : element(std::forward<Args>(args)...), next(0) {}
+    };
+
+    static constexpr uintptr_t mark_bit = 1;
+
+    static Node* pointer(uintptr_t link) noexcept { return reinterpret_cast<Node*>(link & ~mark_bit); }
+    static bool marked(uintptr_t link) noexcept { return (link & mark_bit) != 0; }
+    static uintptr_t link_to(Node* node) noexcept { return reinterpret_cast<uintptr_t>(node); }
+
+    std::atomic<uintptr_t> head;
+    std::atomic<size_t> element_count;
+    [[no_unique_address]] Compare comp;
+
+    // Returns the link that points at the first node not less than value, and that node.
+    // Marked nodes met on the way are unlinked and retired.
+    std::pair<std::atomic<uintptr_t>*, Node*> search(const T& value) {
+    retry:
+        std::atomic<uintptr_t>* previous = &head;
+        Node* current = pointer(previous->load(std::memory_order_acquire));
+        while (current) {
+            uintptr_t next = current->next.load(std::memory_order_acquire);
+            if (marked(next)) {
+                uintptr_t expected = link_to(current);
+                if (!previous->compare_exchange_strong(expected, next & ~mark_bit, std::memory_order_acq_rel,
+                                                       std::memory_order_relaxed)) {
+                    goto retry;
+                }
+                EpochReclaimer::instance().retire(current);
+                current = pointer(next);
+                continue;
+            }
+            if (!comp(current->element, value)) break;
+            previous = &current->next;
+            current = pointer(next);
+        }
+        return {previous, current};
+    }
+
+    bool equivalent(const T& a, const T& b) const {
+        return !comp(a, b) && !comp(b, a);
+    }
+
+public:
+    LockFreeSortedList() : head(0), element_count(0) {}
+    LockFreeSortedList(const LockFreeSortedList&) = delete;
+    LockFreeSortedList& operator=(const LockFreeSortedList&) = delete;
+
+    // No other thread may use the list any more.
+    ~LockFreeSortedList() {
+        Node* current = pointer(head.load(std::memory_order_acquire));
+        while (current) {
+            Node* next = pointer(current->next.load(std::memory_order_relaxed));
+            delete current;
+            current = next;
+        }
+    }
+
+    bool insert(const T& value) {
+        EpochGuard guard;
+        auto node = std::make_unique<Node>(std::in_place, value);
+        while (true) {
+            auto [previous, current] = search(value);
+            if (current && equivalent(current->element, value)) return false;
+            
+            node->next.store(link_to(current), std::memory_order_relaxed);
+            uintptr_t expected = link_to(current);
+            if (previous->compare_exchange_strong(expected, link_to(node.get()), std::memory_order_release,
+                                                  std::memory_order_relaxed)) {
+                node.release();
+                element_count.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+    }
+
+    bool erase(const T& value) {
+        EpochGuard guard;
+        while (true) {
+            auto [previous, current] = search(value);
+            if (!current || !equivalent(current->element, value)) return false;
+            
+            uintptr_t next = current->next.load(std::memory_order_acquire);
+            if (marked(next)) continue;
+            if (!current->next.compare_exchange_strong(next, next | mark_bit, std::memory_order_acq_rel,
+                                                       std::memory_order_relaxed)) {
+                continue;
+            }
+            element_count.fetch_sub(1, std::memory_order_relaxed);
+            
+            uintptr_t expected = link_to(current);
+            if (previous->compare_exchange_strong(expected, next, std::memory_order_acq_rel,
+                                                  std::memory_order_relaxed)) {
+                EpochReclaimer::instance().retire(current);
+            } else {
+                search(value);
+            }
+            return true;
+        }
+    }
+
+    bool contains(const T& value) const {
+        EpochGuard guard;
+        Node* current = pointer(head.load(std::memory_order_acquire));
+        while (current && comp(current->element, value)) {
+            current = pointer(current->next.load(std::memory_order_acquire));
+        }
+        return current && equivalent(current->element, value) &&
+               !marked(current->next.load(std::memory_order_acquire));
+    }
+
+    // Visits the elements present in ascending order; concurrent updates may or may not be seen.
+    template<typename Function>
+    void for_each(Function&& function) const {
+        EpochGuard guard;
+        Node* current = pointer(head.load(std::memory_order_acquire));
+        while (current) {
+            uintptr_t next = current->next.load(std::memory_order_acquire);
+            if (!marked(next)) function(std::as_const(current->element));
+            current = pointer(next);
+        }
+    }
+
+    // Exact only while no update runs concurrently.
+    size_t size() const { return element_count.load(std::memory_order_relaxed); }
+    bool empty() const { return size() == 0; }
+};
+
+// Lazy list (Heller et al.): updates lock only the two nodes they touch and validate them after
+// locking, removal first sets a marked flag, and contains is wait-free without taking any lock.
+// Same interface as LockFreeSortedList, for comparison.
+template<typename T, typename Compare = std::less<T>>
+class LazySortedList {
+private:
+    struct Node;
+
+    struct Link {
+        std::atomic<Node*> next{nullptr};
+        std::atomic<bool> marked{false};
+        std::mutex lock;
+    };
+
+    struct Node : Link {
+        T element;
+        
+        template<typename... Args>
+        explicit Node(std::in_place_t, Args&&... args) : element(std::forward<Args>(args)...) {}
+    };
+
+    Link head;
+    std::atomic<size_t> element_count;
+    [[no_unique_address]] Compare comp;
+
+    std::pair<Link*, Node*> search(const T& value) const {
+        Link* previous = const_cast<Link*>(&head);
+        Node* current = previous->next.load(std::memory_order_acquire);
+        while (current && comp(current->element, value)) {
+            previous = current;
+            current = current->next.load(std::memory_order_acquire);
+        }
+        return {previous, current};
+    }
+
+    static bool valid(Link* previous, Node* current) {
+        return !previous->marked.load(std::memory_order_relaxed) &&
+               previous->next.load(std::memory_order_relaxed) == current &&
+               (!current || !current->marked.load(std::memory_order_relaxed));
+    }
+
+    bool equivalent(const T& a, const T& b) const {
+        return !comp(a, b) && !comp(b, a);
+    }
+
+public:
+    LazySortedList() : element_count(0) {}
+    LazySortedList(const LazySortedList&) = delete;
+    LazySortedList& operator=(const LazySortedList&) = delete;
+
+    ~LazySortedList() {
+        Node* current = head.next.load(std::memory_order_acquire);
+        while (current) {
+            Node* next = current->next.load(std::memory_order_relaxed);
+            delete current;
+            current = next;
+        }
+    }
+
+    bool insert(const T& value) {
+        EpochGuard guard;
+        auto node = std::make_unique<Node>(std::in_place, value);
+        while (true) {
+            auto [previous, current] = search(value);
+            std::lock_guard<std::mutex> previous_lock(previous->lock);
+            if (!valid(previous, current)) continue;
+            if (current && equivalent(current->element, value)) return false;
+            
+            node->next.store(current, std::memory_order_relaxed);
+            previous->next.store(node.release(), std::memory_order_release);
+            element_count.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    bool erase(const T& value) {
+        EpochGuard guard;
+        while (true) {
+            auto [previous, current] = search(value);
+            if (!current || !equivalent(current->element, value)) return false;
+            
+            std::scoped_lock locks(previous->lock, current->lock);
+            if (!valid(previous, current)) continue;
+            
+            current->marked.store(true, std::memory_order_release);
+            previous->next.store(current->next.load(std::memory_order_relaxed), std::memory_order_release);
+            element_count.fetch_sub(1, std::memory_order_relaxed);
+            EpochReclaimer::instance().retire(current);
+            return true;
+        }
+    }
+
+    bool contains(const T& value) const {
+        EpochGuard guard;
+        Node* current = search(value).second;
+        return current && equivalent(current->element, value) && !current->marked.load(std::memory_order_acquire);
+    }
+
+    template<typename Function>
+    void for_each(Function&& function) const {
+        EpochGuard guard;
+        for (Node* current = head.next.load(std::memory_order_acquire); current;
+             current = current->next.load(std::memory_order_acquire)) {
+            if (!current->marked.load(std::memory_order_acquire)) function(std::as_const(current->element));
+        }
+    }
+
+    size_t size() const { return element_count.load(std::memory_order_relaxed); }
+    bool empty() const { return size() == 0; }
+};
+
+template<typename T>
+struct PersistentTreeNode {
+    T element;
+    std::shared_ptr<const PersistentTreeNode<T>> left;
+    std::shared_ptr<const PersistentTreeNode<T>> right;
+    size_t size;
+    int height;
+
+    PersistentTreeNode(const T& element,
+                       std::shared_ptr<const PersistentTreeNode<T>> left,
+                       std::shared_ptr<const PersistentTreeNode<T>> right)
+        : element(element), left(std::move(left)), right(std::move(right)), size(1), height(1) {
+        if (this->left) {
+            size += this->left->size;
+            height = this->left->height + 1;
+        }
+        if (this->right) {
+            size += this->right->size;
+            height = std::max(height, this->right->height + 1);
+        }
+    }
+};
+
+template<typename T>
+class SharedListOperationsKit {
+private:
+    using NodePtr = std::shared_ptr<const PersistentTreeNode<T>>;
+
+    NodePtr root;
+
+    static size_t size_of(const NodePtr& node) noexcept { return node ? node->size : 0; }
+    static int height_of(const NodePtr& node) noexcept { return node ? node->height : 0; }
+
+    static NodePtr make_node(const T& element, NodePtr left, NodePtr right) {
+        return std::make_shared<const PersistentTreeNode<T>>(element, std::move(left), std::move(right));
+    }
+
+    static NodePtr balance(const T& element, NodePtr left, NodePtr right) {
+        int hl = height_of(left);
+        int hr = height_of(right);
+        
+        if (hl > hr + 1) {
+            if (height_of(left->left) >= height_of(left->right)) {
+                return make_node(left->element, left->left, make_node(element, left->right, std::move(right)));
+            }
+            return make_node(left->right->element,
+                             make_node(left->element, left->left, left->right->left),
+                             make_node(element, left->right->right, std::move(right)));
+        }
+        
+        if (hr > hl + 1) {
+            if (height_of(right->right) >= height_of(right->left)) {
+                return make_node(right->element, make_node(element, std::move(left), right->left), right->right);
+            }
+            return make_node(right->left->element,
+                             make_node(element, std::move(left), right->left->left),
+                             make_node(right->element, right->left->right, right->right));
+        }
+        
+        return make_node(element, std::move(left), std::move(right));
+    }
+
+    static NodePtr insert_node(const NodePtr& node, size_t index, const T& value) {
+        if (!node) return make_node(value, nullptr, nullptr);
+        
+        size_t left_size = size_of(node->left);
+        if (index <= left_size) {
+            return balance(node->element, insert_node(node->left, index, value), node->right);
+        }
+        return balance(node->element, node->left, insert_node(node->right, index - left_size - 1, value));
+    }
+
+    static NodePtr remove_min(const NodePtr& node) {
+        if (!node->left) return node->right;
+        return balance(node->element, remove_min(node->left), node->right);
+    }
+
+    static NodePtr remove_node(const NodePtr& node, size_t index) {
+        size_t left_size = size_of(node->left);
+        
+        if (index < left_size) {
+            return balance(node->element, remove_node(node->left, index), node->right);
+        }
+        if (index > left_size) {
+            return balance(node->element, node->left, remove_node(node->right, index - left_size - 1));
+        }
+        
+        if (!node->left) return node->right;
+        if (!node->right) return node->left;
+        
+        const PersistentTreeNode<T>* successor = node->right.get();
+        while (successor->left) {
+            successor = successor->left.get();
+        }
+        return balance(successor->element, node->left, remove_min(node->right));
+    }
+
+    static NodePtr set_node(const NodePtr& node, size_t index, const T& value) {
+        size_t left_size = size_of(node->left);
+        
+        if (index < left_size) {
+            return make_node(node->element, set_node(node->left, index, value), node->right);
+        }
+        if (index > left_size) {
+            return make_node(node->element, node->left, set_node(node->right, index - left_size - 1, value));
+        }
+        return make_node(value, node->left, node->right);
+    }
+
+    template<typename Iterator>
+    static NodePtr build(Iterator& it, size_t count) {
+        if (count == 0) return nullptr;
+        
+        NodePtr left = build(it, count / 2);
+        const T& element = *it;
+        ++it;
+        NodePtr right = build(it, count - count / 2 - 1);
+        return make_node(element, std::move(left), std::move(right));
+    }
+
+    const PersistentTreeNode<T>* node_at(size_t index) const {
+        if (index >= size()) throw std::out_of_range("Index out of bounds");
+        
+        const PersistentTreeNode<T>* current = root.get();
+        while (true) {
+            size_t left_size = size_of(current->left);
+            if (index < left_size) {
+                current = current->left.get();
+            } else if (index > left_size) {
+                index -= left_size + 1;
+                current = current->right.get();
+            } else {
+                return current;
+            }
+        }
+    }
+
+public:
+    using value_type = T;
+    using size_type = size_t;
+    using difference_type = std::ptrdiff_t;
+    using const_reference = const T&;
+    using const_pointer = const T*;
+
+    class const_iterator {
+    private:
+        std::vector<const PersistentTreeNode<T>*> path;
+
+        void push_left(const PersistentTreeNode<T>* node) {
+            while (node) {
+                path.push_back(node);
+                node = node->left.get();
+            }
+        }
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        const_iterator() = default;
+        explicit const_iterator(const PersistentTreeNode<T>* root) { push_left(root); }
+        const T& operator*() const { return path.back()->element; }
+        const T* operator->() const { return &path.back()->element; }
+        const_iterator& operator++() {
+            const PersistentTreeNode<T>* node = path.back();
+            path.pop_back();
+            push_left(node->right.get());
+            return *this;
+        }
+        const_iterator operator++(int) {
+            const_iterator tmp = *this;
+            ++*this;
+            return tmp;
+        }
+        bool operator==(const const_iterator& other) const {
+            if (path.empty() || other.path.empty()) return path.empty() == other.path.empty();
+            return path.back() == other.path.back();
+        }
+        bool operator!=(const const_iterator& other) const { return !(*this == other); }
+    };
+
+    using iterator = const_iterator;
+
+    SharedListOperationsKit() = default;
+
+    SharedListOperationsKit(std::initializer_list<T> init) {
+        auto it = init.begin();
+        root = build(it, init.size());
+    }
+
+    template<typename NodeStorage, typename Aggregate>
+    explicit SharedListOperationsKit(const ListOperationsKit<T, NodeStorage, Aggregate>& list) {
+        auto it = list.begin();
+        root = build(it, list.size());
+    }
+
+    SharedListOperationsKit(const SharedListOperationsKit&) = default;
+    SharedListOperationsKit(SharedListOperationsKit&&) noexcept = default;
+    SharedListOperationsKit& operator=(const SharedListOperationsKit&) = default;
+    SharedListOperationsKit& operator=(SharedListOperationsKit&&) noexcept = default;
+    ~SharedListOperationsKit() = default;
+
+    SharedListOperationsKit snapshot() const { return *this; }
+
+    const_iterator begin() const { return const_iterator(root.get()); }
+    const_iterator cbegin() const { return const_iterator(root.get()); }
+    const_iterator end() const { return const_iterator(); }
+    const_iterator cend() const { return const_iterator(); }
+
+    bool empty() const noexcept { return !root; }
+    size_t size() const noexcept { return size_of(root); }
+
+    const T& front() const {
+        if (empty()) throw std::out_of_range("List is empty");
+        return node_at(0)->element;
+    }
+
+    const T& back() const {
+        if (empty()) throw std::out_of_range("List is empty");
+        return node_at(size() - 1)->element;
+    }
+
+    const T& get(size_t index) const { return node_at(index)->element; }
+    const T& operator[](size_t index) const { return node_at(index)->element; }
+
+    void clear() noexcept { root.reset(); }
+
+    void push_front(const T& value) { root = insert_node(root, 0, value); }
+    void push_back(const T& value) { root = insert_node(root, size(), value); }
+
+    void append(const T& element) { 
+        push_back(element); 
+    }
+
+    template<typename... Args>
+    void append(const T& element, Args&&... args) {
+        push_back(element);
+        append(std::forward<Args>(args)...);
+    }
+
+    void insert_at(size_t index, const T& element) {
+        if (index > size()) throw std::out_of_range("Index out of bounds");
+        root = insert_node(root, index, element);
+    }
+
+    void pop_front() {
+        if (empty()) throw std::out_of_range("List is empty");
+        root = remove_node(root, 0);
+    }
+
+    void pop_back() {
+        if (empty()) throw std::out_of_range("List is empty");
+        root = remove_node(root, size() - 1);
+    }
+
+    void remove(size_t index) {
+        if (index >= size()) throw std::out_of_range("Index out of bounds");
+        root = remove_node(root, index);
+    }
+
+    void set(size_t index, const T& value) {
+        if (index >= size()) throw std::out_of_range("Index out of bounds");
+        root = set_node(root, index, value);
+    }
+
+    ListOperationsKit<T> to_list() const {
+        ListOperationsKit<T> result;
+        for (const auto& item : *this) {
+            result.push_back(item);
+        }
+        return result;
+    }
+
+    std::string to_string() const {
+        std::stringstream ss;
+        auto it = cbegin();
+        while (it != cend()) {
+            ss << *it;
+            if (++it != cend()) {
+                ss << " ";
+            }
+        }
+        return ss.str();
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, const SharedListOperationsKit& list) {
+        for (const auto& item : list) {
+            os << item << " ";
+        }
+        return os;
+    }
+
+    bool operator==(const SharedListOperationsKit& other) const {
+        if (root == other.root) return true;
+        if (size() != other.size()) return false;
+        return std::equal(begin(), end(), other.begin());
+    }
+
+    bool operator!=(const SharedListOperationsKit& other) const {
+        return !(*this == other);
+    }
+
+    size_t get_size() const { return size(); }
+    size_t length() const { return size(); }
+};
+
+// Struct-of-arrays list: every field of a row is kept in its own column, and the rows are split
+// into chunks of at most chunk_capacity, each holding one contiguous vector per column. A scan of
+// one field streams plain arrays (sum/min/max compile to vectorizable loops) without touching
+// the other fields, while insert_at/remove shift elements within a single chunk only.
+template<typename... Fields>
+class ColumnarListOperationsKit {
+    static_assert(sizeof...(Fields) > 0, "ColumnarListOperationsKit needs at least one field");
+
+public:
+    using row_type = std::tuple<Fields...>;
+
+    template<size_t Column>
+    using column_type = std::tuple_element_t<Column, row_type>;
+
+    static constexpr size_t chunk_capacity = 1024;
+
+private:
+    struct Chunk {
+        std::tuple<std::vector<Fields>...> columns;
+
+        Chunk() {
+            std::apply([](auto&... column) { (column.reserve(chunk_capacity), ...); }, columns);
+        }
+
+        size_t size() const noexcept { return std::get<0>(columns).size(); }
+    };
+
+    std::vector<Chunk> chunks;
+    size_t row_count;
+
+    void check_index(size_t index) const {
+        if (index >= row_count) throw std::out_of_range("Index out of bounds");
+    }
+
+    // Chunk and offset of row `index`; for index == size() the end of the last chunk.
+    std::pair<size_t, size_t> locate(size_t index) const noexcept {
+        size_t chunk = 0;
+        while (chunk + 1 < chunks.size() && index >= chunks[chunk].size()) {
+            index -= chunks[chunk].size();
+            ++chunk;
+        }
+        return {chunk, index};
+    }
+
+    // Moves the upper half of a full chunk into a new chunk right after it.
+    void split(size_t chunk) {
+        chunks.insert(chunks.begin() + chunk + 1, Chunk());
+        Chunk& source = chunks[chunk];
+        Chunk& target = chunks[chunk + 1];
+        const size_t half = source.size() / 2;
+        move_tail(source, target, half, std::index_sequence_for<Fields...>());
+    }
+
+    template<size_t... I>
+    static void move_tail(Chunk& source, Chunk& target, size_t from, std::index_sequence<I...>) {
+        ((std::get<I>(target.columns).insert(std::get<I>(target.columns).end(),
+                                             std::make_move_iterator(std::get<I>(source.columns).begin() + from),
+                                             std::make_move_iterator(std::get<I>(source.columns).end())),
+          std::get<I>(source.columns).erase(std::get<I>(source.columns).begin() + from, std::get<I>(source.columns).end())), ...);
+    }
+
+    template<size_t... I, typename... Values>
+    static void insert_row(Chunk& chunk, size_t offset, std::index_sequence<I...>, Values&&... values) {
+        size_t inserted = 0;
+        try {
+            ((std::get<I>(chunk.columns).insert(std::get<I>(chunk.columns).begin() + offset, std::forward<Values>(values)),
+              ++inserted), ...);
+        } catch (...) {
+            ((I < inserted ? void(std::get<I>(chunk.columns).erase(std::get<I>(chunk.columns).begin() + offset)) : void()), ...);
+            throw;
+        }
+    }
+
+    template<size_t... I>
+    static void assign_row(Chunk& chunk, size_t offset, std::index_sequence<I...>, const Fields&... values) {
+        ((std::get<I>(chunk.columns)[offset] = values), ...);
+    }
+
+    // Keeps chunks at least a quarter full after removals so that scans stay dense.
+    void merge_sparse(size_t chunk) {
+        if (chunks[chunk].size() == 0) {
+            chunks.erase(chunks.begin() + chunk);
+            return;
+        }
+        if (chunks[chunk].size() >= chunk_capacity / 4) return;
+        if (chunk + 1 < chunks.size() && chunks[chunk].size() + chunks[chunk + 1].size() <= chunk_capacity) {
+            move_tail(chunks[chunk + 1], chunks[chunk], 0, std::index_sequence_for<Fields...>());
+            chunks.erase(chunks.begin() + chunk + 1);
+        } else if (chunk > 0 && chunks[chunk - 1].size() + chunks[chunk].size() <= chunk_capacity) {
+            move_tail(chunks[chunk], chunks[chunk - 1], 0, std::index_sequence_for<Fields...>());
+            chunks.erase(chunks.begin() + chunk);
+        }
+    }
+
+    template<size_t Column>
+    void gather_column(std::vector<Chunk>& target, const std::vector<size_t>& order) {
+        std::vector<column_type<Column>> values = take_column<Column>();
+        for (size_t i = 0; i < order.size(); ++i) {
+            std::get<Column>(target[i / chunk_capacity].columns).push_back(std::move(values[order[i]]));
+        }
+    }
+
+    template<size_t... I>
+    void gather(std::vector<Chunk>& target, const std::vector<size_t>& order, std::index_sequence<I...>) {
+        (gather_column<I>(target, order), ...);
+    }
+
+    // Rebuilds the list with row order[i] at position i, in full chunks.
+    void permute(const std::vector<size_t>& order) {
+        std::vector<Chunk> target((row_count + chunk_capacity - 1) / chunk_capacity);
+        gather(target, order, std::index_sequence_for<Fields...>());
+        chunks = std::move(target);
+    }
+
+    template<size_t... I>
+    bool column_values_equal(const ColumnarListOperationsKit& other, std::index_sequence<I...>) const {
+        return ((column_values<I>() == other.template column_values<I>()) && ...);
+    }
+
+    template<size_t Column>
+    std::vector<column_type<Column>> take_column() {
+        std::vector<column_type<Column>> values;
+        values.reserve(row_count);
+        for (Chunk& chunk : chunks) {
+            auto& column = std::get<Column>(chunk.columns);
+            values.insert(values.end(), std::make_move_iterator(column.begin()), std::make_move_iterator(column.end()));
+        }
+        return values;
+    }
+
+public:
+    ColumnarListOperationsKit() : row_count(0) {}
+
+    ColumnarListOperationsKit(std::initializer_list<row_type> init) : row_count(0) {
+        for (const auto& row : init) {
+            push_back(row);
+        }
+    }
+
+    bool empty() const noexcept { return row_count == 0; }
+    size_t size() const noexcept { return row_count; }
+    size_t chunk_count() const noexcept { return chunks.size(); }
+
+    void clear() noexcept {
+        chunks.clear();
+        row_count = 0;
+    }
+
+    void push_back(const Fields&... values) {
+        if (chunks.empty() || chunks.back().size() == chunk_capacity) chunks.emplace_back();
+        try {
+            insert_row(chunks.back(), chunks.back().size(), std::index_sequence_for<Fields...>(), values...);
+        } catch (...) {
+            if (chunks.back().size() == 0) chunks.pop_back();
+            throw;
+        }
+        ++row_count;
+    }
+
+    void push_back(const row_type& row) {
+        std::apply([this](const Fields&... values) { push_back(values...); }, row);
+    }
+
+    void append(const Fields&... values) {
+        push_back(values...);
+    }
+
+    void insert_at(size_t index, const Fields&... values) {
+        if (index > row_count) throw std::out_of_range("Index out of bounds");
+        if (index == row_count) {
+            push_back(values...);
+            return;
+        }
+        auto [chunk, offset] = locate(index);
+        if (chunks[chunk].size() == chunk_capacity) {
+            split(chunk);
+            if (offset > chunks[chunk].size()) {
+                offset -= chunks[chunk].size();
+                ++chunk;
+            }
+        }
+        insert_row(chunks[chunk], offset, std::index_sequence_for<Fields...>(), values...);
+        ++row_count;
+    }
+
+    void insert_at(size_t index, const row_type& row) {
+        std::apply([this, index](const Fields&... values) { insert_at(index, values...); }, row);
+    }
+
+    void remove(size_t index) {
+        check_index(index);
+        auto [chunk, offset] = locate(index);
+        std::apply([offset](auto&... column) { (column.erase(column.begin() + offset), ...); }, chunks[chunk].columns);
+        --row_count;
+        merge_sparse(chunk);
+    }
+
+    row_type get(size_t index) const {
+        check_index(index);
+        auto [chunk, offset] = locate(index);
+        return std::apply([offset](const auto&... column) { return row_type(column[offset]...); }, chunks[chunk].columns);
+    }
+
+    template<size_t Column>
+    column_type<Column>& get(size_t index) {
+        check_index(index);
+        auto [chunk, offset] = locate(index);
+        return std::get<Column>(chunks[chunk].columns)[offset];
+    }
+
+    template<size_t Column>
+    const column_type<Column>& get(size_t index) const {
+        check_index(index);
+        auto [chunk, offset] = locate(index);
+        return std::get<Column>(chunks[chunk].columns)[offset];
+    }
+
+    void set(size_t index, const Fields&... values) {
+        check_index(index);
+        auto [chunk, offset] = locate(index);
+        assign_row(chunks[chunk], offset, std::index_sequence_for<Fields...>(), values...);
+    }
+
+    template<size_t Column>
+    void set(size_t index, const column_type<Column>& value) {
+        get<Column>(index) = value;
+    }
+
+    // Stable sort of whole rows by one column.
+    template<size_t Column, typename Compare = std::less<>>
+    void sort(Compare comp = Compare()) {
+        std::vector<std::pair<column_type<Column>, size_t>> keyed;
+        keyed.reserve(row_count);
+        for_each_chunk<Column>([&](std::span<const column_type<Column>> values) {
+            for (const auto& value : values) {
+                keyed.emplace_back(value, keyed.size());
+            }
+        });
+        std::stable_sort(keyed.begin(), keyed.end(), [&](const auto& a, const auto& b) { return comp(a.first, b.first); });
+        
+        std::vector<size_t> order(row_count);
+        for (size_t i = 0; i < row_count; ++i) {
+            order[i] = keyed[i].second;
+        }
+        permute(order);
+    }
+
+    template<size_t Column>
+    void sort(bool descending) {
+        if (descending) {
+            sort<Column>(std::greater<>());
+        } else {
+            sort<Column>(std::less<>());
+        }
+    }
+
+    ColumnarListOperationsKit slice(size_t start, size_t end, size_t step = 1) const {
+        ColumnarListOperationsKit result;
+        if (start >= row_count || step == 0) return result;
+        end = std::min(end, row_count);
+        
+        size_t position = 0;
+        for (const Chunk& chunk : chunks) {
+            for (size_t offset = 0; offset < chunk.size() && position < end; ++offset, ++position) {
+                if (position >= start && (position - start) % step == 0) {
+                    std::apply([&](const auto&... column) { result.push_back(column[offset]...); }, chunk.columns);
+                }
+            }
+        }
+        return result;
+    }
+
+    // Calls function(std::span<column_type<Column>>) once per chunk, in row order.
+    template<size_t Column, typename Function>
+    void for_each_chunk(Function function) {
+        for (Chunk& chunk : chunks) {
+            auto& column = std::get<Column>(chunk.columns);
+            function(std::span<column_type<Column>>(column.data(), column.size()));
+        }
+    }
+
+    template<size_t Column, typename Function>
+    void for_each_chunk(Function function) const {
+        for (const Chunk& chunk : chunks) {
+            const auto& column = std::get<Column>(chunk.columns);
+            function(std::span<const column_type<Column>>(column.data(), column.size()));
+        }
+    }
+
+    template<size_t Column, typename Result, typename BinaryOperation = std::plus<>>
+    Result reduce(Result init, BinaryOperation op = BinaryOperation()) const {
+        for_each_chunk<Column>([&](std::span<const column_type<Column>> values) {
+            for (size_t i = 0; i < values.size(); ++i) {
+                init = op(init, values[i]);
+            }
+        });
+        return init;
+    }
+
+    template<size_t Column>
+    column_type<Column> sum() const {
+        return reduce<Column>(column_type<Column>{});
+    }
+
+    template<size_t Column>
+    column_type<Column> min() const {
+        if (empty()) throw std::out_of_range("List is empty");
+        column_type<Column> result = std::get<Column>(chunks.front().columns).front();
+        for_each_chunk<Column>([&](std::span<const column_type<Column>> values) {
+            for (size_t i = 0; i < values.size(); ++i) {
+                result = values[i] < result ? values[i] : result;
+            }
+        });
+        return result;
+    }
+
+    template<size_t Column>
+    column_type<Column> max() const {
+        if (empty()) throw std::out_of_range("List is empty");
+        column_type<Column> result = std::get<Column>(chunks.front().columns).front();
+        for_each_chunk<Column>([&](std::span<const column_type<Column>> values) {
+            for (size_t i = 0; i < values.size(); ++i) {
+                result = result < values[i] ? values[i] : result;
+            }
+        });
+        return result;
+    }
+
+    template<size_t Column, typename Predicate>
+    size_t count_if(Predicate pred) const {
+        size_t matches = 0;
+        for_each_chunk<Column>([&](std::span<const column_type<Column>> values) {
+            for (size_t i = 0; i < values.size(); ++i) {
+                matches += pred(values[i]) ? 1 : 0;
+            }
+        });
+        return matches;
+    }
+
+    template<size_t Column>
+    std::vector<column_type<Column>> column_values() const {
+        std::vector<column_type<Column>> values;
+        values.reserve(row_count);
+        for_each_chunk<Column>([&](std::span<const column_type<Column>> chunk) {
+            values.insert(values.end(), chunk.begin(), chunk.end());
+        });
+        return values;
+    }
+
+    std::string to_string() const {
+        std::stringstream ss;
+        ss << *this;
+        std::string result = ss.str();
+        if (!result.empty()) result.pop_back();
+        return result;
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, const ColumnarListOperationsKit& list) {
+        for (const Chunk& chunk : list.chunks) {
+            for (size_t offset = 0; offset < chunk.size(); ++offset) {
+                os << "(";
+                std::apply([&](const auto&... column) {
+                    size_t field = 0;
+                    ((os << (field++ ? ", " : "") << column[offset]), ...);
+                }, chunk.columns);
+                os << ") ";
+            }
+        }
+        return os;
+    }
+
+    bool operator==(const ColumnarListOperationsKit& other) const {
+        if (row_count != other.row_count) return false;
+        return column_values_equal(other, std::index_sequence_for<Fields...>());
+    }
+
+    bool operator!=(const ColumnarListOperationsKit& other) const {
+        return !(*this == other);
+    }
+};
+
+// Sorted (non-decreasing) integer sequence stored as blocks of block_capacity values: each block
+// keeps its first value in a skip table, and the gaps between the remaining values are LEB128
+// varints in one shared byte buffer. Dense IDs cost about one byte each, sequential decoding is a
+// byte loop, and lookups binary-search the skip table and decode a single block.
+template<std::integral T>
+class CompressedListOperationsKit {
+public:
+    static constexpr size_t block_capacity = 128;
+
+private:
+    using unsigned_type = std::make_unsigned_t<T>;
+
+    struct Block {
+        T first;
+        size_t offset;
+    };
+
+    std::vector<Block> blocks;
+    std::vector<uint8_t> bytes;
+    size_t list_size;
+    T last_value;
+
+    static void write_varint(std::vector<uint8_t>& out, unsigned_type value) {
+        while (value >= 0x80) {
+            out.push_back(static_cast<uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<uint8_t>(value));
+    }
+
+    static unsigned_type read_varint(const uint8_t*& cursor) noexcept {
+        unsigned_type byte = *cursor++;
+        if (byte < 0x80) return byte;
+        unsigned_type value = byte & 0x7f;
+        unsigned shift = 7;
+        do {
+            byte = *cursor++;
+            value |= (byte & 0x7f) << shift;
+            shift += 7;
+        } while (byte & 0x80);
+        return value;
+    }
+
+public:
+    class const_iterator {
+    private:
+        const CompressedListOperationsKit* owner;
+        size_t position;
+        const uint8_t* cursor;
+        T value;
+
+        friend class CompressedListOperationsKit;
+
+        const_iterator(const CompressedListOperationsKit* owner, size_t position) noexcept
+            : owner(owner), position(position), cursor(nullptr), value() {
+            if (position < owner->list_size) enter_block(position / block_capacity);
+        }
+
+        void enter_block(size_t block) noexcept {
+            value = owner->blocks[block].first;
+            cursor = owner->bytes.data() + owner->blocks[block].offset;
+        }
+
+    public:
+        // Values are decoded into the iterator itself, so it is an input iterator yielding copies:
+        // a reference into it would dangle once the iterator is advanced or destroyed.
+        using iterator_category = std::input_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = T;
+
+        const_iterator() noexcept : owner(nullptr), position(0), cursor(nullptr), value() {}
+
+        reference operator*() const noexcept { return value; }
+
+        const_iterator& operator++() noexcept {
+            if (++position >= owner->list_size) return *this;
+            if (position % block_capacity == 0) {
+                enter_block(position / block_capacity);
+            } else {
+                value = static_cast<T>(static_cast<unsigned_type>(value) + read_varint(cursor));
+            }
+            return *this;
+        }
+
+        const_iterator operator++(int) noexcept {
+            const_iterator tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        size_t index() const noexcept { return position; }
+
+        bool operator==(const const_iterator& other) const noexcept { return position == other.position; }
+        bool operator!=(const const_iterator& other) const noexcept { return position != other.position; }
+    };
+
+    using iterator = const_iterator;
+
+    CompressedListOperationsKit() : list_size(0), last_value() {}
+
+    CompressedListOperationsKit(std::initializer_list<T> init) : CompressedListOperationsKit() {
+        for (T value : init) {
+            append(value);
+        }
+    }
+
+    const_iterator begin() const noexcept { return const_iterator(this, 0); }
+    const_iterator end() const noexcept { return const_iterator(this, list_size); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+
+    bool empty() const noexcept { return list_size == 0; }
+    size_t size() const noexcept { return list_size; }
+
+    // Bytes held by the encoding (skip table and varint buffer), excluding unused capacity.
+    size_t compressed_bytes() const noexcept {
+        return blocks.size() * sizeof(Block) + bytes.size();
+    }
+
+    void clear() noexcept {
+        blocks.clear();
+        bytes.clear();
+        list_size = 0;
+        last_value = T();
+    }
+
+    void shrink_to_fit() {
+        blocks.shrink_to_fit();
+        bytes.shrink_to_fit();
+    }
+
+    T front() const {
+        if (empty()) throw std::out_of_range("List is empty");
+        return blocks.front().first;
+    }
+
+    T back() const {
+        if (empty()) throw std::out_of_range("List is empty");
+        return last_value;
+    }
+
+    void append(T value) {
+        if (!empty() && value < last_value) throw std::invalid_argument("Values must be appended in sorted order");
+        if (list_size % block_capacity == 0) {
+            blocks.push_back(Block{value, bytes.size()});
+        } else {
+            write_varint(bytes, static_cast<unsigned_type>(static_cast<unsigned_type>(value) - static_cast<unsigned_type>(last_value)));
+        }
+        last_value = value;
+        ++list_size;
+    }
+
+    template<typename... Args>
+    void append(T value, T next, Args... rest) {
+        append(value);
+        append(next, rest...);
+    }
+
+    void push_back(T value) { append(value); }
+
+    T get(size_t index) const {
+        if (index >= list_size) throw std::out_of_range("Index out of bounds");
+        const_iterator it(this, index - index % block_capacity);
+        for (size_t i = index % block_capacity; i > 0; --i) {
+            ++it;
+        }
+        return *it;
+    }
+
+    T operator[](size_t index) const { return get(index); }
+
+    // First element not less than value. The skip table is searched from `from`'s block onward,
+    // so repeated calls with increasing values (as in set_intersection) only move forward.
+    const_iterator lower_bound(T value, const_iterator from) const noexcept {
+        if (from.position >= list_size) return end();
+        auto first_block = blocks.begin() + static_cast<std::ptrdiff_t>(from.position / block_capacity + 1);
+        auto next_block = std::upper_bound(first_block, blocks.end(), value,
+                                           [](T v, const Block& block) { return v <= block.first; });
+        if (next_block != first_block) {
+            const size_t block = static_cast<size_t>(next_block - blocks.begin()) - 1;
+            from = const_iterator(this, block * block_capacity);
+        }
+        while (from.position < list_size && *from < value) {
+            ++from;
+        }
+        return from;
+    }
+
+    const_iterator lower_bound(T value) const noexcept {
+        return lower_bound(value, begin());
+    }
+
+    bool contains(T value) const noexcept {
+        const_iterator it = lower_bound(value);
+        return it != end() && *it == value;
+    }
+
+    size_t find_index(T value) const noexcept {
+        const_iterator it = lower_bound(value);
+        return it != end() && *it == value ? it.position : std::numeric_limits<size_t>::max();
+    }
+
+    size_t index(T value) const {
+        size_t position = find_index(value);
+        if (position == std::numeric_limits<size_t>::max()) throw std::out_of_range("Element not found in list");
+        return position;
+    }
+
+    size_t count(T value) const noexcept {
+        size_t matches = 0;
+        for (const_iterator it = lower_bound(value); it != end() && *it == value; ++it) {
+            ++matches;
+        }
+        return matches;
+    }
+
+    CompressedListOperationsKit slice(size_t start, size_t end, size_t step = 1) const {
+        CompressedListOperationsKit result;
+        if (start >= list_size || step == 0) return result;
+        end = std::min(end, list_size);
+        
+        const_iterator it(this, start - start % block_capacity);
+        while (it.position < start) {
+            ++it;
+        }
+        for (; it.position < end; ++it) {
+            if ((it.position - start) % step == 0) result.append(*it);
+        }
+        return result;
+    }
+
+    // Both lists are sorted, so these are single linear passes; other is left unchanged and
+    // duplicates follow std::merge / std::set_intersection multiset semantics.
+    void merge(const CompressedListOperationsKit& other) {
+        CompressedListOperationsKit result;
+        const_iterator a = begin();
+        const_iterator b = other.begin();
+        while (a != end() && b != other.end()) {
+            if (*b < *a) {
+                result.append(*b);
+                ++b;
+            } else {
+                result.append(*a);
+                ++a;
+            }
+        }
+        for (; a != end(); ++a) result.append(*a);
+        for (; b != other.end(); ++b) result.append(*b);
+        *this = std::move(result);
+    }
+
+    // Skips whole blocks of either list through the skip table, so intersecting a short list with
+    // a long one decodes only the blocks that can contain matches.
+    void set_intersection(const CompressedListOperationsKit& other) {
+        CompressedListOperationsKit result;
+        const_iterator a = begin();
+        const_iterator b = other.begin();
+        while (a != end() && b != other.end()) {
+            if (*a < *b) {
+                a = lower_bound(*b, a);
+            } else if (*b < *a) {
+                b = other.lower_bound(*a, b);
+            } else {
+                result.append(*a);
+                ++a;
+                ++b;
+            }
+        }
+        *this = std::move(result);
+    }
+
+    ListOperationsKit<T> to_list() const {
+        ListOperationsKit<T> result;
+        for (T value : *this) {
+            result.push_back(value);
+        }
+        return result;
+    }
+
+    std::string to_string() const {
+        std::stringstream ss;
+        for (const_iterator it = begin(); it != end();) {
+            ss << *it;
+            if (++it != end()) ss << " ";
+        }
+        return ss.str();
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, const CompressedListOperationsKit& list) {
+        for (T value : list) {
+            os << value << " ";
+        }
+        return os;
+    }
+
+    bool operator==(const CompressedListOperationsKit& other) const noexcept {
+        return list_size == other.list_size && std::equal(begin(), end(), other.begin());
+    }
+
+    bool operator!=(const CompressedListOperationsKit& other) const noexcept {
+        return !(*this == other);
+    }
+};
+
 #endif // ListOperationsKit_H
\ No newline at end of file
@@ -0,0 +1,74 @@
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <numeric>
+#include <random>
+
+#include "ListOperationsKit.h"
+#include "bench_common.h"
+
+// Sliding window: every step pushes one sample, drops the oldest, and reads sum/min/max.
+void compare(size_t window, size_t steps) {
+    std::mt19937_64 rng(window);
+    std::vector<int64_t> samples(steps);
+    for (auto& sample : samples) {
+        sample = static_cast<int64_t>(rng() % 1'000'000);
+    }
+    int64_t sink = 0;
+    
+    std::cout << "window = " << window << ", steps = " << steps << " (per step)\n";
+    report("ListOperationsKit + rescan for sum/min/max", steps, best_seconds(3, [&] {
+        ListOperationsKit<int64_t> values;
+        for (int64_t sample : samples) {
+            values.push_back(sample);
+            if (values.size() > window) values.pop_front();
+            sink += std::accumulate(values.begin(), values.end(), int64_t(0));
+            sink += *std::min_element(values.begin(), values.end()) + *std::max_element(values.begin(), values.end());
+        }
+    }));
+    report("AggregatingListOperationsKit<Sum, MinMax>", steps, best_seconds(3, [&] {
+        AggregatingListOperationsKit<int64_t, SumAggregate, MinMaxAggregate> values;
+        for (int64_t sample : samples) {
+            values.push_back(sample);
+            if (values.size() > window) values.pop_front();
+            sink += values.sum() + values.min() + values.max();
+        }
+    }));
+    report("AggregatingLinkedQueue<Sum, WindowMinMax>", steps, best_seconds(3, [&] {
+        AggregatingLinkedQueue<int64_t, SumAggregate, WindowMinMaxAggregate> values;
+        for (int64_t sample : samples) {
+            values.push(sample);
+            if (values.size() > window) values.pop();
+            sink += values.sum() + values.min() + values.max();
+        }
+    }));
+    
+    report("LinkedQueue push/pop only", steps, best_seconds(3, [&] {
+        LinkedQueue<int64_t> values;
+        for (int64_t sample : samples) {
+            values.push(sample);
+            if (values.size() > window) values.pop();
+        }
+        sink += values.back();
+    }));
+    report("AggregatingLinkedQueue<> (no policies) push/pop", steps, best_seconds(3, [&] {
+        AggregatingLinkedQueue<int64_t> values;
+        for (int64_t sample : samples) {
+            values.push(sample);
+            if (values.size() > window) values.pop();
+        }
+        sink += values.back();
+    }));
+    
+    if (sink == 42) std::cout << "";
+}
+
+int main(int argc, char** argv) {
+    size_t steps = bench_arg(argc, argv, 1, 20'000);
+    
+    std::cout << "Incremental aggregates vs rescanning benchmark\n";
+    for (size_t window : {64, 4096}) {
+        compare(window, steps);
+    }
+    return 0;
+}
@@ -0,0 +1,86 @@
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "ListOperationsKit.h"
+#include "bench_common.h"
+
+ListOperationsKit<uint64_t> make_list(size_t n) {
+    ListOperationsKit<uint64_t> list;
+    for (size_t i = 0; i < n; ++i) {
+        list.push_back(i);
+    }
+    return list;
+}
+
+std::vector<size_t> random_indices(size_t n, size_t k, uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    std::vector<size_t> indices(n);
+    for (size_t i = 0; i < n; ++i) {
+        indices[i] = i;
+    }
+    std::shuffle(indices.begin(), indices.end(), rng);
+    indices.resize(k);
+    return indices;
+}
+
+void compare(size_t n, size_t k) {
+    ListOperationsKit<uint64_t> list = make_list(n);
+    std::vector<size_t> indices = random_indices(n, k, n + k);
+    uint64_t sink = 0;
+    
+    std::cout << "n = " << n << ", k = " << k << " (per index)\n";
+    report("get(i) loop", k, best_seconds(3, [&] {
+        for (size_t index : indices) {
+            sink += list.get(index);
+        }
+    }));
+    report("get_many()", k, best_seconds(3, [&] {
+        for (const uint64_t& value : list.get_many(indices)) {
+            sink += value;
+        }
+    }));
+    
+    std::vector<uint64_t> values(k, 7);
+    report("set(i, v) loop", k, best_seconds(3, [&] {
+        for (size_t i = 0; i < k; ++i) {
+            list.set(indices[i], values[i]);
+        }
+    }));
+    report("set_many()", k, best_seconds(3, [&] { list.set_many(indices, values); }));
+    
+    std::vector<size_t> descending = indices;
+    std::sort(descending.begin(), descending.end(), std::greater<size_t>());
+    report("remove(i) loop", k, best_seconds(1, [&] {
+        for (size_t index : descending) {
+            list.remove(index);
+        }
+    }));
+    list = make_list(n);
+    report("remove_many()", k, best_seconds(1, [&] { list.remove_many(indices); }));
+    
+    std::vector<size_t> positions = random_indices(n - k, k, n);
+    std::sort(positions.begin(), positions.end(), std::greater<size_t>());
+    report("insert_at(i, v) loop", k, best_seconds(1, [&] {
+        for (size_t i = 0; i < k; ++i) {
+            list.insert_at(positions[i], values[i]);
+        }
+    }));
+    list = make_list(n - k);
+    report("insert_many()", k, best_seconds(1, [&] { list.insert_many(positions, values); }));
+    
+    if (sink == 42) std::cout << "";
+}
+
+int main(int argc, char** argv) {
+    size_t n = bench_arg(argc, argv, 1, 100'000);
+    
+    std::cout << "Batched vs per-index positional access benchmark\n";
+    for (size_t k : {16, 256, 4096}) {
+        compare(n, std::min(k, n / 2));
+    }
+    return 0;
+}
@@ -0,0 +1,83 @@
+#ifndef BENCH_COMMON_H
+#define BENCH_COMMON_H
+
+#include <algorithm>
+#include <cstddef>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+inline size_t bench_arg(int argc, char** argv, int position, size_t fallback) {
+    if (argc > position) return static_cast<size_t>(std::strtoull(argv[position], nullptr, 10));
+    return fallback;
+}
+
+template<typename Function>
+double best_seconds(int repeats, Function&& function) {
+    double best = 1e300;
+    for (int i = 0; i < repeats; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        function();
+        auto end = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double>(end - start).count());
+    }
+    return best;
+}
+
+inline void report(const std::string& name, size_t elements, double seconds) {
+    std::cout << "  " << std::left << std::setw(44) << name
+              << std::right << std::setw(10) << std::fixed << std::setprecision(2)
+              << seconds * 1e3 << " ms"
+              << std::setw(10) << std::setprecision(2)
+              << (seconds * 1e9 / static_cast<double>(elements)) << " ns/elem\n";
+}
+
+// Allocates `count` blocks of `bytes` and frees them in random order, so that
+// the allocator hands later allocations of that size back at scattered
+// addresses, mimicking a list that has been through long insert/remove churn.
+// Keep the object alive until those allocations are done: releasing the
+// (large) pointer array makes glibc consolidate the freed blocks again.
+class HeapFragmenter {
+private:
+    std::vector<void*> blocks;
+
+public:
+    HeapFragmenter(size_t count, size_t bytes, size_t alignment = alignof(std::max_align_t), uint64_t seed = 42)
+        : blocks(count) {
+        const bool over_aligned = alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+        for (auto& block : blocks) {
+            block = over_aligned ? ::operator new(bytes, std::align_val_t(alignment)) : ::operator new(bytes);
+        }
+        std::shuffle(blocks.begin(), blocks.end(), std::mt19937_64(seed));
+        for (auto block : blocks) {
+            if (over_aligned) {
+                ::operator delete(block, std::align_val_t(alignment));
+            } else {
+                ::operator delete(block);
+            }
+        }
+    }
+};
+
+template<typename List>
+double adjacent_node_ratio(const List& list, size_t node_bytes) {
+    if (list.size() < 2) return 1.0;
+    size_t adjacent = 0;
+    auto it = list.begin();
+    auto previous = reinterpret_cast<uintptr_t>(&*it);
+    for (++it; it != list.end(); ++it) {
+        auto current = reinterpret_cast<uintptr_t>(&*it);
+        auto distance = current > previous ? current - previous : previous - current;
+        if (distance <= 2 * node_bytes) ++adjacent;
+        previous = current;
+    }
+    return static_cast<double>(adjacent) / static_cast<double>(list.size() - 1);
+}
+
+#endif // BENCH_COMMON_H
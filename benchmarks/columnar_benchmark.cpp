@@ -0,0 +1,56 @@
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <random>
+
+#include "ListOperationsKit.h"
+#include "bench_common.h"
+
+struct Record {
+    uint64_t id;
+    uint64_t timestamp;
+    int64_t value;
+    char payload[40];
+};
+
+void compare(size_t n) {
+    ListOperationsKit<Record> rows;
+    ColumnarListOperationsKit<uint64_t, uint64_t, int64_t> columns;
+    std::mt19937_64 rng(n);
+    for (size_t i = 0; i < n; ++i) {
+        Record record{i, rng() % 1'000'000, static_cast<int64_t>(rng() % 1000) - 500, {}};
+        rows.push_back(record);
+        columns.push_back(record.id, record.timestamp, record.value);
+    }
+    int64_t sink = 0;
+    
+    std::cout << "n = " << n << " (per row)\n";
+    report("ListOperationsKit<Record> sum of value", n, best_seconds(5, [&] {
+        int64_t total = 0;
+        for (const Record& record : rows) {
+            total += record.value;
+        }
+        sink += total;
+    }));
+    report("Columnar sum<2>()", n, best_seconds(5, [&] { sink += columns.sum<2>(); }));
+    report("ListOperationsKit<Record> count value > 0", n, best_seconds(5, [&] {
+        sink += std::count_if(rows.begin(), rows.end(), [](const Record& record) { return record.value > 0; });
+    }));
+    report("Columnar count_if<2>(value > 0)", n, best_seconds(5, [&] {
+        sink += columns.count_if<2>([](int64_t value) { return value > 0; });
+    }));
+    report("ListOperationsKit<Record> sort by timestamp", n, best_seconds(1, [&] {
+        rows.sort([](const Record& a, const Record& b) { return a.timestamp < b.timestamp; });
+    }));
+    report("Columnar sort<1>()", n, best_seconds(1, [&] { columns.sort<1>(); }));
+    
+    if (sink == 42) std::cout << "";
+}
+
+int main(int argc, char** argv) {
+    size_t n = bench_arg(argc, argv, 1, 1'000'000);
+    
+    std::cout << "Node-per-record vs columnar single-field scans benchmark\n";
+    compare(n);
+    return 0;
+}
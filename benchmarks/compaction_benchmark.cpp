@@ -0,0 +1,39 @@
+#include <cstdint>
+#include <iostream>
+#include <numeric>
+
+#include "ListOperationsKit.h"
+#include "bench_common.h"
+
+int main(int argc, char** argv) {
+    const size_t n = bench_arg(argc, argv, 1, 10'000'000);
+    using List = ListOperationsKit<uint64_t>;
+    
+    std::cout << "compact() benchmark: " << n << " elements\n";
+    
+    List list;
+    {
+        HeapFragmenter fragmenter(n, sizeof(List::node_type));
+        for (size_t i = 0; i < n; ++i) {
+            list.push_back(i);
+        }
+    }
+    
+    uint64_t sink = 0;
+    auto traverse = [&] { sink += std::accumulate(list.begin(), list.end(), uint64_t{0}); };
+    
+    std::cout << "  adjacent nodes before: " << std::fixed << std::setprecision(1)
+              << adjacent_node_ratio(list, sizeof(List::node_type)) * 100.0 << "%\n";
+    report("traversal, fragmented", n, best_seconds(1, traverse));
+    report("compact()", n, best_seconds(1, [&] { list.compact(); }));
+    std::cout << "  adjacent nodes after: " << std::fixed << std::setprecision(1)
+              << adjacent_node_ratio(list, sizeof(List::node_type)) * 100.0 << "%\n";
+    report("traversal, compacted", n, best_seconds(3, traverse));
+    
+    std::vector<uint64_t> array(list.begin(), list.end());
+    report("traversal, std::vector reference", n,
+           best_seconds(3, [&] { sink += std::accumulate(array.begin(), array.end(), uint64_t{0}); }));
+    
+    if (sink == 42) std::cout << "";
+    return 0;
+}
@@ -0,0 +1,78 @@
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "ListOperationsKit.h"
+#include "bench_common.h"
+
+// Sorted IDs with random gaps averaging `mean_gap`.
+std::vector<uint64_t> sorted_ids(size_t n, uint64_t mean_gap, uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    std::vector<uint64_t> ids(n);
+    uint64_t id = 1'000'000'000;
+    for (auto& value : ids) {
+        id += 1 + rng() % (2 * mean_gap);
+        value = id;
+    }
+    return ids;
+}
+
+void compare(size_t n, uint64_t mean_gap) {
+    const std::vector<uint64_t> ids = sorted_ids(n, mean_gap, n);
+    ListOperationsKit<uint64_t> list;
+    CompressedListOperationsKit<uint64_t> compressed;
+    for (uint64_t id : ids) {
+        list.push_back(id);
+        compressed.append(id);
+    }
+    std::vector<uint64_t> probes(10'000);
+    std::mt19937_64 rng(mean_gap);
+    for (auto& probe : probes) {
+        probe = ids[rng() % n] + (rng() & 1);
+    }
+    uint64_t sink = 0;
+    
+    std::cout << "n = " << n << ", mean gap = " << mean_gap << "\n";
+    std::cout << "  ListOperationsKit<uint64_t>: " << n * (sizeof(DoublyChainNode<uint64_t>) + 8) / n
+              << " bytes/ID (node + malloc header), CompressedListOperationsKit: "
+              << static_cast<double>(compressed.compressed_bytes()) / static_cast<double>(n) << " bytes/ID\n";
+    report("ListOperationsKit iterate (per ID)", n, best_seconds(3, [&] {
+        for (uint64_t id : list) sink += id;
+    }));
+    report("Compressed iterate (per ID)", n, best_seconds(3, [&] {
+        for (uint64_t id : compressed) sink += id;
+    }));
+    report("Compressed contains (per probe)", probes.size(), best_seconds(3, [&] {
+        for (uint64_t probe : probes) sink += compressed.contains(probe);
+    }));
+    
+    CompressedListOperationsKit<uint64_t> sample;
+    for (size_t i = 0; i < n; i += 1000) {
+        sample.append(ids[i]);
+    }
+    report("Compressed set_intersection, n/1000 vs n (per ID)", n, best_seconds(3, [&] {
+        CompressedListOperationsKit<uint64_t> result = sample;
+        result.set_intersection(compressed);
+        sink += result.size();
+    }));
+    report("std::set_intersection on vectors (per ID)", n, best_seconds(3, [&] {
+        std::vector<uint64_t> sample_ids(sample.begin(), sample.end());
+        std::vector<uint64_t> result;
+        std::set_intersection(sample_ids.begin(), sample_ids.end(), ids.begin(), ids.end(), std::back_inserter(result));
+        sink += result.size();
+    }));
+    
+    if (sink == 42) std::cout << "";
+}
+
+int main(int argc, char** argv) {
+    size_t n = bench_arg(argc, argv, 1, 2'000'000);
+    
+    std::cout << "Delta/varint compressed sorted list benchmark\n";
+    for (uint64_t gap : {4, 100, 10'000}) {
+        compare(n, gap);
+    }
+    return 0;
+}
@@ -0,0 +1,124 @@
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ListOperationsKit.h"
+#include "bench_common.h"
+
+// The baseline the concurrent lists replace: one sorted ListOperationsKit behind one lock.
+class LockedSortedList {
+private:
+    ListOperationsKit<uint64_t> list;
+    mutable std::mutex lock;
+
+public:
+    bool insert(uint64_t value) {
+        std::lock_guard<std::mutex> guard(lock);
+        size_t index = 0;
+        for (uint64_t element : list) {
+            if (element == value) return false;
+            if (element > value) break;
+            ++index;
+        }
+        list.insert_at(index, value);
+        return true;
+    }
+
+    bool erase(uint64_t value) {
+        std::lock_guard<std::mutex> guard(lock);
+        size_t index = 0;
+        for (uint64_t element : list) {
+            if (element == value) {
+                list.remove(index);
+                return true;
+            }
+            if (element > value) break;
+            ++index;
+        }
+        return false;
+    }
+
+    bool contains(uint64_t value) const {
+        std::lock_guard<std::mutex> guard(lock);
+        for (uint64_t element : list) {
+            if (element >= value) return element == value;
+        }
+        return false;
+    }
+};
+
+template<typename List>
+double run_mix(size_t threads, size_t operations, uint64_t key_range, unsigned update_percent) {
+    List list;
+    std::mt19937_64 fill(7);
+    for (uint64_t i = 0; i < key_range / 2; ++i) {
+        list.insert(fill() % key_range);
+    }
+    
+    std::atomic<bool> start(false);
+    std::atomic<size_t> hits(0);
+    std::vector<std::thread> workers;
+    size_t per_thread = operations / threads;
+    for (size_t t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            std::mt19937_64 rng(t + 1);
+            size_t found = 0;
+            while (!start.load()) {
+                std::this_thread::yield();
+            }
+            for (size_t i = 0; i < per_thread; ++i) {
+                uint64_t key = rng() % key_range;
+                unsigned roll = static_cast<unsigned>(rng() % 100);
+                if (roll < update_percent / 2) {
+                    found += list.insert(key);
+                } else if (roll < update_percent) {
+                    found += list.erase(key);
+                } else {
+                    found += list.contains(key);
+                }
+            }
+            hits += found;
+        });
+    }
+    
+    double seconds = best_seconds(1, [&] {
+        start.store(true);
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    });
+    if (hits.load() == 0) std::cout << "  no operation succeeded\n";
+    return seconds;
+}
+
+int main(int argc, char** argv) {
+    size_t operations = bench_arg(argc, argv, 1, 400'000);
+    uint64_t key_range = bench_arg(argc, argv, 2, 1024);
+    size_t max_threads = bench_arg(argc, argv, 3, std::max(1u, std::thread::hardware_concurrency()));
+    
+    std::cout << "Concurrent sorted list benchmark, " << operations << " operations, keys in [0, " << key_range
+              << "), hardware threads: " << std::thread::hardware_concurrency() << "\n";
+    std::vector<size_t> thread_counts;
+    for (size_t threads = 1; threads < max_threads; threads *= 2) {
+        thread_counts.push_back(threads);
+    }
+    thread_counts.push_back(max_threads);
+    
+    for (unsigned update_percent : {10u, 50u}) {
+        for (size_t threads : thread_counts) {
+            std::cout << update_percent << "% updates, " << threads << " thread(s)\n";
+            report("LockFreeSortedList", operations,
+                   run_mix<LockFreeSortedList<uint64_t>>(threads, operations, key_range, update_percent));
+            report("LazySortedList", operations,
+                   run_mix<LazySortedList<uint64_t>>(threads, operations, key_range, update_percent));
+            report("std::mutex + ListOperationsKit", operations,
+                   run_mix<LockedSortedList>(threads, operations, key_range, update_percent));
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,87 @@
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+
+#include "ListOperationsKit.h"
+#include "bench_common.h"
+
+struct Payload {
+    uint64_t key;
+    char bytes[88];
+
+    bool operator==(const Payload& other) const { return key == other.key; }
+    bool operator!=(const Payload& other) const { return key != other.key; }
+    bool operator<(const Payload& other) const { return key < other.key; }
+};
+
+template<typename List, typename Value>
+void run_scans(const std::string& label, const List& list, const List& twin, const Value& missing, int repeats) {
+    const size_t n = list.size();
+    size_t sink = 0;
+    
+    std::cout << label << " (adjacent nodes: " << std::setprecision(1) << std::fixed
+              << adjacent_node_ratio(list, sizeof(typename List::node_type)) * 100.0 << "%)\n";
+    report("std::count over iterators (no prefetch)", n,
+           best_seconds(repeats, [&] { sink += std::count(list.begin(), list.end(), missing); }));
+    report("count() (prefetch)", n,
+           best_seconds(repeats, [&] { sink += list.count(missing); }));
+    report("find_index() miss (prefetch)", n,
+           best_seconds(repeats, [&] { sink += list.find_index(missing); }));
+    report("operator== (prefetch, two lists)", 2 * n,
+           best_seconds(repeats, [&] { sink += (list == twin); }));
+    if (sink == 42) std::cout << "";
+}
+
+template<typename List, typename Make>
+void build(List& list, size_t n, bool scattered, Make make) {
+    using node_type = typename List::node_type;
+    HeapFragmenter fragmenter(scattered ? n : 0, sizeof(node_type), alignof(node_type));
+    for (size_t i = 0; i < n; ++i) {
+        list.push_back(make(i));
+    }
+}
+
+int main(int argc, char** argv) {
+    const size_t n = bench_arg(argc, argv, 1, 16'000'000);
+    const size_t large_n = bench_arg(argc, argv, 2, n / 8);
+    auto make_id = [](size_t i) { return static_cast<uint64_t>(i); };
+    auto make_payload = [](size_t i) { return Payload{static_cast<uint64_t>(i), {}}; };
+    
+    std::cout << "Node layout / prefetch scan benchmark\n";
+    std::cout << "uint64_t lists: " << n << " nodes x " << sizeof(DoublyChainNode<uint64_t>) << " B = "
+              << n * sizeof(DoublyChainNode<uint64_t>) / (1 << 20) << " MiB per list\n";
+    
+    for (bool scattered : {false, true}) {
+        ListOperationsKit<uint64_t> list;
+        ListOperationsKit<uint64_t> twin;
+        build(list, n, scattered, make_id);
+        build(twin, n, scattered, make_id);
+        run_scans(scattered ? "uint64_t, scattered nodes" : "uint64_t, sequential nodes",
+                  list, twin, uint64_t(~0ull), scattered ? 1 : 3);
+    }
+    
+    std::cout << "\nPayload lists: " << large_n << " nodes, "
+              << sizeof(DoublyChainNode<Payload>) << " B default vs "
+              << sizeof(DoublyChainNode<Payload, cache_line_size>) << " B cache-aligned\n";
+    
+    for (bool scattered : {false, true}) {
+        ListOperationsKit<Payload> list;
+        ListOperationsKit<Payload> twin;
+        build(list, large_n, scattered, make_payload);
+        build(twin, large_n, scattered, make_payload);
+        run_scans(scattered ? "Payload default, scattered" : "Payload default, sequential",
+                  list, twin, Payload{~0ull, {}}, scattered ? 1 : 3);
+    }
+    
+    // glibc serves over-aligned blocks by splitting larger chunks, so the
+    // fragmenter cannot scatter them; only the sequential case is measured.
+    {
+        CacheAlignedListOperationsKit<Payload> list;
+        CacheAlignedListOperationsKit<Payload> twin;
+        build(list, large_n, false, make_payload);
+        build(twin, large_n, false, make_payload);
+        run_scans("Payload cache-aligned, sequential", list, twin, Payload{~0ull, {}}, 3);
+    }
+    
+    return 0;
+}
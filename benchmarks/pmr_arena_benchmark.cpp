@@ -0,0 +1,82 @@
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <memory_resource>
+#include <vector>
+
+#include "ListOperationsKit.h"
+#include "bench_common.h"
+
+// One "request": build `lists` short-lived lists of `n` elements, read them, drop them all.
+template<typename List, typename MakeList>
+uint64_t serve_request(size_t lists, size_t n, MakeList&& make_list) {
+    uint64_t sum = 0;
+    std::vector<List> working;
+    working.reserve(lists);
+    for (size_t l = 0; l < lists; ++l) {
+        List& list = working.emplace_back(make_list());
+        for (size_t i = 0; i < n; ++i) {
+            list.push_back(i + l);
+        }
+        sum += list.back();
+    }
+    return sum;
+}
+
+void compare(size_t requests, size_t lists, size_t n) {
+    const size_t elements = requests * lists * n;
+    std::vector<std::byte> buffer(lists * n * sizeof(DoublyChainNode<uint64_t>) + 4096);
+    uint64_t sink = 0;
+    
+    std::cout << requests << " requests x " << lists << " lists x " << n << " elements (per element)\n";
+    report("ListOperationsKit (new/delete)", elements, best_seconds(3, [&] {
+        for (size_t r = 0; r < requests; ++r) {
+            sink += serve_request<ListOperationsKit<uint64_t>>(lists, n, [] { return ListOperationsKit<uint64_t>(); });
+        }
+    }));
+    report("PmrListOperationsKit (pool resource)", elements, best_seconds(3, [&] {
+        for (size_t r = 0; r < requests; ++r) {
+            std::pmr::unsynchronized_pool_resource pool;
+            sink += serve_request<PmrListOperationsKit<uint64_t>>(lists, n, [&] { return PmrListOperationsKit<uint64_t>(&pool); });
+        }
+    }));
+    report("PmrListOperationsKit (monotonic arena)", elements, best_seconds(3, [&] {
+        for (size_t r = 0; r < requests; ++r) {
+            std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size());
+            sink += serve_request<PmrListOperationsKit<uint64_t>>(lists, n, [&] { return PmrListOperationsKit<uint64_t>(&arena); });
+        }
+    }));
+    
+    report("LinkedQueue push/drop (new/delete)", elements, best_seconds(3, [&] {
+        for (size_t r = 0; r < requests; ++r) {
+            LinkedQueue<uint64_t> queue;
+            for (size_t i = 0; i < lists * n; ++i) {
+                queue.push(i);
+            }
+            sink += queue.back();
+        }
+    }));
+    report("PmrLinkedQueue push/drop (monotonic arena)", elements, best_seconds(3, [&] {
+        for (size_t r = 0; r < requests; ++r) {
+            std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size());
+            PmrLinkedQueue<uint64_t> queue(&arena);
+            for (size_t i = 0; i < lists * n; ++i) {
+                queue.push(i);
+            }
+            sink += queue.back();
+        }
+    }));
+    
+    if (sink == 42) std::cout << "";
+}
+
+int main(int argc, char** argv) {
+    size_t requests = bench_arg(argc, argv, 1, 2'000);
+    size_t lists = bench_arg(argc, argv, 2, 16);
+    size_t n = bench_arg(argc, argv, 3, 64);
+    
+    std::cout << "Per-node heap vs memory_resource arena benchmark\n";
+    compare(requests, lists, n);
+    return 0;
+}
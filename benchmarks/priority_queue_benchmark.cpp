@@ -0,0 +1,119 @@
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <queue>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "ListOperationsKit.h"
+#include "bench_common.h"
+
+struct Edge {
+    uint32_t to;
+    uint32_t weight;
+};
+
+using Graph = std::vector<std::vector<Edge>>;
+using Entry = std::pair<uint64_t, uint32_t>;   // (distance, vertex)
+
+constexpr uint64_t unreached = std::numeric_limits<uint64_t>::max();
+
+Graph random_graph(size_t vertices, size_t degree, uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    Graph graph(vertices);
+    for (size_t v = 0; v < vertices; ++v) {
+        for (size_t e = 0; e < degree; ++e) {
+            graph[v].push_back(Edge{static_cast<uint32_t>(rng() % vertices), static_cast<uint32_t>(1 + rng() % 1000)});
+        }
+    }
+    return graph;
+}
+
+// Lazy deletion: stale entries stay in the heap and are skipped when popped.
+std::vector<uint64_t> dijkstra_std(const Graph& graph, size_t& pushes) {
+    std::vector<uint64_t> distance(graph.size(), unreached);
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> frontier;
+    distance[0] = 0;
+    frontier.push({0, 0});
+    while (!frontier.empty()) {
+        auto [d, v] = frontier.top();
+        frontier.pop();
+        if (d != distance[v]) continue;
+        for (const Edge& edge : graph[v]) {
+            if (d + edge.weight < distance[edge.to]) {
+                distance[edge.to] = d + edge.weight;
+                frontier.push({distance[edge.to], edge.to});
+                ++pushes;
+            }
+        }
+    }
+    return distance;
+}
+
+// decrease_key through handles: every vertex is in the heap at most once.
+std::vector<uint64_t> dijkstra_linked(const Graph& graph, size_t& pushes) {
+    using Queue = LinkedPriorityQueue<Entry, std::greater<Entry>>;
+    std::vector<uint64_t> distance(graph.size(), unreached);
+    std::vector<Queue::handle> handles(graph.size());
+    std::vector<bool> settled(graph.size(), false);
+    Queue frontier;
+    distance[0] = 0;
+    handles[0] = frontier.insert({0, 0});
+    while (!frontier.empty()) {
+        auto [d, v] = frontier.top();
+        frontier.pop();
+        settled[v] = true;
+        for (const Edge& edge : graph[v]) {
+            if (settled[edge.to] || d + edge.weight >= distance[edge.to]) continue;
+            distance[edge.to] = d + edge.weight;
+            if (handles[edge.to]) {
+                frontier.decrease_key(handles[edge.to], {distance[edge.to], edge.to});
+            } else {
+                handles[edge.to] = frontier.insert({distance[edge.to], edge.to});
+                ++pushes;
+            }
+        }
+    }
+    return distance;
+}
+
+void compare(size_t vertices, size_t degree) {
+    const Graph graph = random_graph(vertices, degree, vertices * degree);
+    size_t std_pushes = 0;
+    size_t linked_pushes = 0;
+    std::vector<uint64_t> expected;
+    std::vector<uint64_t> actual;
+    
+    std::cout << vertices << " vertices, " << vertices * degree << " edges (per edge)\n";
+    report("std::priority_queue (lazy deletion)", vertices * degree,
+           best_seconds(3, [&] { std_pushes = 0; expected = dijkstra_std(graph, std_pushes); }));
+    report("LinkedPriorityQueue (decrease_key)", vertices * degree,
+           best_seconds(3, [&] { linked_pushes = 0; actual = dijkstra_linked(graph, linked_pushes); }));
+    std::cout << "  heap pushes: " << std_pushes << " vs " << linked_pushes
+              << ", distances match: " << (expected == actual ? "yes" : "NO") << "\n";
+    
+    report("std::priority_queue push + pop", vertices, best_seconds(3, [&] {
+        std::priority_queue<uint64_t, std::vector<uint64_t>, std::greater<uint64_t>> heap;
+        std::mt19937_64 rng(1);
+        for (size_t i = 0; i < vertices; ++i) heap.push(rng());
+        while (!heap.empty()) heap.pop();
+    }));
+    report("LinkedPriorityQueue push + pop", vertices, best_seconds(3, [&] {
+        LinkedPriorityQueue<uint64_t, std::greater<uint64_t>> heap;
+        std::mt19937_64 rng(1);
+        for (size_t i = 0; i < vertices; ++i) heap.push(rng());
+        while (!heap.empty()) heap.pop();
+    }));
+}
+
+int main(int argc, char** argv) {
+    size_t vertices = bench_arg(argc, argv, 1, 200'000);
+    
+    std::cout << "Pairing heap vs std::priority_queue benchmark\n";
+    for (size_t degree : {4, 16}) {
+        compare(vertices, degree);
+    }
+    return 0;
+}
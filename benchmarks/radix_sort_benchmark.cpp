@@ -0,0 +1,83 @@
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "ListOperationsKit.h"
+#include "bench_common.h"
+
+struct Record {
+    uint64_t id;
+    uint32_t key;
+    double value;
+};
+
+template<typename T, typename Generate, typename Sort>
+double time_sort(ListOperationsKit<T>& list, const std::vector<T>& values, Generate&&, Sort&& sort) {
+    auto it = list.begin();
+    for (const auto& value : values) {
+        *it = value;
+        ++it;
+    }
+    return best_seconds(1, [&] { sort(list); });
+}
+
+template<typename T, typename Generate>
+void compare(const std::string& label, size_t n, Generate generate) {
+    std::mt19937_64 rng(n);
+    std::vector<T> values(n);
+    for (auto& value : values) {
+        value = generate(rng);
+    }
+    ListOperationsKit<T> list;
+    for (const auto& value : values) {
+        list.push_back(value);
+    }
+    
+    std::cout << label << ", n = " << n << "\n";
+    report("comparison sort(std::less<T>())", n,
+           time_sort(list, values, generate, [](auto& l) { l.sort(std::less<T>()); }));
+    report("radix sort()", n,
+           time_sort(list, values, generate, [](auto& l) { l.sort(); }));
+    report("comparison sort(std::greater<T>())", n,
+           time_sort(list, values, generate, [](auto& l) { l.sort(std::greater<T>()); }));
+    report("radix sort(true)", n,
+           time_sort(list, values, generate, [](auto& l) { l.sort(true); }));
+}
+
+void compare_records(size_t n) {
+    std::mt19937_64 rng(n);
+    ListOperationsKit<Record> list;
+    for (size_t i = 0; i < n; ++i) {
+        list.push_back(Record{i, static_cast<uint32_t>(rng()), 0.0});
+    }
+    
+    std::cout << "Record by uint32_t key, n = " << n << "\n";
+    report("comparison sort(key less)", n, best_seconds(1, [&] {
+        list.sort([](const Record& a, const Record& b) { return a.key < b.key; });
+    }));
+    list.sort_by_key([](const Record& r) { return r.id; });
+    report("radix sort_by_key(key)", n, best_seconds(1, [&] {
+        list.sort_by_key([](const Record& r) { return r.key; });
+    }));
+}
+
+int main(int argc, char** argv) {
+    std::vector<size_t> sizes;
+    for (int i = 1; i < argc; ++i) {
+        sizes.push_back(bench_arg(argc, argv, i, 0));
+    }
+    if (sizes.empty()) sizes = {1'000'000, 10'000'000};
+    
+    std::cout << "Radix vs comparison sort benchmark\n";
+    for (size_t n : sizes) {
+        compare<uint64_t>("uint64_t", n, [](std::mt19937_64& rng) { return rng(); });
+        compare<uint64_t>("uint64_t IDs below 2^32", n, [](std::mt19937_64& rng) { return rng() >> 32; });
+        compare<double>("double", n, [](std::mt19937_64& rng) {
+            return std::uniform_real_distribution<double>(-1e9, 1e9)(rng);
+        });
+        compare_records(n);
+    }
+    return 0;
+}
@@ -0,0 +1,60 @@
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "ListOperationsKit.h"
+#include "bench_common.h"
+
+template<typename Append>
+void run_producers(size_t threads, size_t per_thread, Append&& append) {
+    std::vector<std::thread> producers;
+    for (size_t t = 0; t < threads; ++t) {
+        producers.emplace_back([&, t] {
+            for (size_t i = 0; i < per_thread; ++i) {
+                append(static_cast<uint64_t>(t * per_thread + i));
+            }
+        });
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+}
+
+void compare(size_t threads, size_t per_thread) {
+    const size_t total = threads * per_thread;
+    size_t sink = 0;
+    
+    std::cout << threads << " threads x " << per_thread << " appends (per append, including drain)\n";
+    report("mutex + ListOperationsKit::push_back", total, best_seconds(3, [&] {
+        ListOperationsKit<uint64_t> list;
+        std::mutex lock;
+        run_producers(threads, per_thread, [&](uint64_t value) {
+            std::lock_guard<std::mutex> guard(lock);
+            list.push_back(value);
+        });
+        sink += list.size();
+    }));
+    report("ShardedListOperationsKit + drain()", total, best_seconds(3, [&] {
+        ShardedListOperationsKit<uint64_t> sharded;
+        run_producers(threads, per_thread, [&](uint64_t value) { sharded.append(value); });
+        sink += sharded.drain().size();
+    }));
+    report("ShardedListOperationsKit(global_order) + drain()", total, best_seconds(3, [&] {
+        ShardedListOperationsKit<uint64_t> sharded(true);
+        run_producers(threads, per_thread, [&](uint64_t value) { sharded.append(value); });
+        sink += sharded.drain().size();
+    }));
+    
+    if (sink == 42) std::cout << "";
+}
+
+int main(int argc, char** argv) {
+    size_t threads = bench_arg(argc, argv, 1, std::max(4u, std::thread::hardware_concurrency()));
+    size_t per_thread = bench_arg(argc, argv, 2, 250'000);
+    
+    std::cout << "Sharded per-thread append vs single mutex benchmark\n";
+    compare(threads, per_thread);
+    return 0;
+}
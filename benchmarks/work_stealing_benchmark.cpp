@@ -0,0 +1,111 @@
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+#include "ListOperationsKit.h"
+#include "bench_common.h"
+
+uint64_t parallel_sum(WorkStealingThreadPool& pool, const uint64_t* data, size_t n, size_t cutoff) {
+    if (n <= cutoff) return std::accumulate(data, data + n, uint64_t(0));
+    
+    uint64_t left = 0;
+    uint64_t right = 0;
+    pool.invoke([&] { left = parallel_sum(pool, data, n / 2, cutoff); },
+                [&] { right = parallel_sum(pool, data + n / 2, n - n / 2, cutoff); });
+    return left + right;
+}
+
+uint64_t fib(uint64_t n) {
+    return n < 2 ? n : fib(n - 1) + fib(n - 2);
+}
+
+uint64_t parallel_fib(WorkStealingThreadPool& pool, uint64_t n, uint64_t cutoff) {
+    if (n <= cutoff) return fib(n);
+    
+    uint64_t a = 0;
+    uint64_t b = 0;
+    pool.invoke([&] { a = parallel_fib(pool, n - 1, cutoff); },
+                [&] { b = parallel_fib(pool, n - 2, cutoff); });
+    return a + b;
+}
+
+void owner_throughput(size_t operations) {
+    std::cout << "Owner push/pop, " << operations << " operations\n";
+    
+    WorkStealingDeque<uint64_t> deque;
+    uint64_t sink = 0;
+    report("WorkStealingDeque push + try_pop", operations, best_seconds(3, [&] {
+        for (size_t i = 0; i < operations; ++i) {
+            deque.push(i);
+        }
+        while (std::optional<uint64_t> value = deque.try_pop()) {
+            sink += *value;
+        }
+    }));
+    
+    LinkedStack<uint64_t> stack;
+    std::mutex lock;
+    report("std::mutex + LinkedStack push + pop", operations, best_seconds(3, [&] {
+        for (size_t i = 0; i < operations; ++i) {
+            std::lock_guard<std::mutex> guard(lock);
+            stack.push(i);
+        }
+        while (true) {
+            std::lock_guard<std::mutex> guard(lock);
+            if (stack.empty()) break;
+            sink += stack.top();
+            stack.pop();
+        }
+    }));
+    if (sink == 42) std::cout << "";
+}
+
+int main(int argc, char** argv) {
+    size_t n = bench_arg(argc, argv, 1, 32'000'000);
+    uint64_t fib_n = bench_arg(argc, argv, 2, 36);
+    size_t max_threads = bench_arg(argc, argv, 3, std::max(1u, std::thread::hardware_concurrency()));
+    
+    std::vector<uint64_t> data(n);
+    std::iota(data.begin(), data.end(), uint64_t(0));
+    uint64_t expected_sum = std::accumulate(data.begin(), data.end(), uint64_t(0));
+    uint64_t expected_fib = fib(fib_n);
+    
+    std::cout << "Work-stealing fork-join benchmark (hardware threads: "
+              << std::thread::hardware_concurrency() << ")\n";
+    std::cout << "sequential\n";
+    report("std::accumulate", n, best_seconds(3, [&] {
+        expected_sum = std::accumulate(data.begin(), data.end(), uint64_t(0));
+    }));
+    report("fib", expected_fib, best_seconds(3, [&] { expected_fib = fib(fib_n); }));
+    
+    std::vector<size_t> thread_counts;
+    for (size_t threads = 1; threads < max_threads; threads *= 2) {
+        thread_counts.push_back(threads);
+    }
+    thread_counts.push_back(max_threads);
+    
+    for (size_t threads : thread_counts) {
+        WorkStealingThreadPool pool(threads);
+        std::cout << threads << " thread(s)\n";
+        
+        uint64_t sum = 0;
+        report("parallel sum, 16K-element leaves", n, best_seconds(3, [&] {
+            sum = pool.submit([&] { return parallel_sum(pool, data.data(), n, 16 * 1024); }).get();
+        }));
+        uint64_t result = 0;
+        report("parallel fib, leaves fib(12)", expected_fib, best_seconds(3, [&] {
+            result = pool.submit([&] { return parallel_fib(pool, fib_n, 12); }).get();
+        }));
+        if (sum != expected_sum || result != expected_fib) {
+            std::cout << "  wrong result\n";
+            return 1;
+        }
+    }
+    
+    owner_throughput(n / 8);
+    return 0;
+}
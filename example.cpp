@@ -3,12 +3,22 @@
 #include <vector>
 #include <algorithm>
 #include <chrono>
+#include <functional>
+#include <limits>
+#include <random>
+#include <thread>
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <latch>
+#include <sstream>
+#include <memory_resource>
 
 #include "ListOperationsKit.h"
 
 // Test helper functions
-template<typename T>
-void print_test_result(const std::string& test_name, const ListOperationsKit<T>& list, const std::string& expected = "") {
+template<typename T, typename NodeStorage>
+void print_test_result(const std::string& test_name, const ListOperationsKit<T, NodeStorage>& list, const std::string& expected = "") {
     std::cout << "Test " << test_name << ": ";
     std::cout << list;
     if (!expected.empty()) {
@@ -23,6 +33,124 @@ void separator(const std::string& title) {
     std::cout << std::string(50, '=') << "\n";
 }
 
+// Hash that throws once its call budget runs out (negative budget: never), for exception paths.
+struct FlakyHash {
+    static inline int calls_left = -1;
+    
+    size_t operator()(int value) const {
+        if (calls_left == 0) throw std::bad_alloc();
+        if (calls_left > 0) --calls_left;
+        return std::hash<int>()(value);
+    }
+};
+
+uint64_t parallel_range_sum(WorkStealingThreadPool& pool, uint64_t begin, uint64_t end) {
+    if (end - begin <= 1000) {
+        uint64_t sum = 0;
+        for (uint64_t i = begin; i < end; ++i) {
+            sum += i;
+        }
+        return sum;
+    }
+    
+    uint64_t middle = begin + (end - begin) / 2;
+    uint64_t left = 0;
+    uint64_t right = 0;
+    pool.invoke([&] { left = parallel_range_sum(pool, begin, middle); },
+                [&] { right = parallel_range_sum(pool, middle, end); });
+    return left + right;
+}
+
+AsyncTask consume_one(AsyncLinkedQueue<int>& queue, long long& sum, int& finished) {
+    std::optional<int> value = co_await queue.pop();
+    if (value) sum += *value;
+    ++finished;
+}
+
+AsyncTask produce_range(AsyncLinkedQueue<int>& queue, int first, int last, int& pushed) {
+    for (int i = first; i <= last; ++i) {
+        if (!co_await queue.push(i)) break;
+        ++pushed;
+    }
+}
+
+AsyncTask consume_batch(AsyncLinkedQueue<int>& queue, size_t limit, std::vector<int>& out) {
+    out = co_await queue.pop_up_to(limit);
+}
+
+AsyncTask produce_concurrently(AsyncLinkedQueue<int>& queue, int count, std::latch& done) {
+    for (int i = 1; i <= count; ++i) {
+        co_await queue.push(i);
+    }
+    done.count_down();
+}
+
+AsyncTask consume_until_closed(AsyncLinkedQueue<int>& queue, std::atomic<long long>& sum,
+                               std::atomic<int>& received, std::latch& done) {
+    while (std::optional<int> value = co_await queue.pop()) {
+        sum += *value;
+        ++received;
+    }
+    done.count_down();
+}
+
+template<typename ConcurrentList>
+std::string concurrent_list_contents(const ConcurrentList& list) {
+    std::ostringstream out;
+    list.for_each([&out](int value) { out << value << " "; });
+    return out.str();
+}
+
+template<typename ConcurrentList>
+bool concurrent_list_stress() {
+    ConcurrentList list;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&list, t] {
+            for (int round = 0; round < 200; ++round) {
+                for (int key = t; key < 400; key += 4) {
+                    list.insert(key);
+                }
+                for (int key = t; key < 400; key += 4) {
+                    if (key % 8 >= 4 || round < 199) list.erase(key);
+                }
+                list.contains(round);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    
+    int expected = 0;
+    bool ordered = true;
+    list.for_each([&](int value) {
+        while (expected % 8 >= 4) ++expected;
+        ordered = ordered && value == expected;
+        ++expected;
+    });
+    return ordered && list.size() == 200 && list.contains(3) && !list.contains(4);
+}
+
+// Counts the frees that reach the arena; monotonic_buffer_resource itself ignores them.
+class CountingArena : public std::pmr::monotonic_buffer_resource {
+public:
+    using std::pmr::monotonic_buffer_resource::monotonic_buffer_resource;
+    size_t allocations = 0;
+    size_t deallocations = 0;
+
+protected:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        ++allocations;
+        return std::pmr::monotonic_buffer_resource::do_allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* pointer, size_t bytes, size_t alignment) override {
+        ++deallocations;
+        std::pmr::monotonic_buffer_resource::do_deallocate(pointer, bytes, alignment);
+    }
+};
+
 int main() {
     std::cout << "Modern C++ ListOperationsKit Comprehensive Test\n";
     
@@ -329,6 +457,1130 @@ int main() {
         std::cout << "Using print_reverse(): ";
         reverse_test.print_reverse();
         
+        separator("16. Lazy View Tests");
+        
+        static_assert(std::ranges::bidirectional_range<ListOperationsKit<int>>);
+        static_assert(std::ranges::bidirectional_range<const ListOperationsKit<int>>);
+        
+        ListOperationsKit<int> view_test = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+        
+        std::cout << "view_slice(1, 9, 2): ";
+        for (const auto& val : view_test.view_slice(1, 9, 2)) {
+            std::cout << val << " ";
+        }
+        std::cout << " (Expected: 1 3 5 7)\n";
+        
+        std::cout << "reversed(): ";
+        for (const auto& val : view_test.reversed()) {
+            std::cout << val << " ";
+        }
+        std::cout << " (Expected: 9 8 7 6 5 4 3 2 1 0)\n";
+        
+        std::cout << "filtered(even) | transformed(x * 10): ";
+        for (const auto& val : view_test.filtered([](int x) { return x % 2 == 0; })
+                                   | std::views::transform([](int x) { return x * 10; })) {
+            std::cout << val << " ";
+        }
+        std::cout << " (Expected: 0 20 40 60 80)\n";
+        
+        std::cout << "transformed(x + 1) | take(3): ";
+        for (const auto& val : view_test.transformed([](int x) { return x + 1; }) | std::views::take(3)) {
+            std::cout << val << " ";
+        }
+        std::cout << " (Expected: 1 2 3)\n";
+        
+        std::cout << "drop(2) | take(4) | reverse: ";
+        for (const auto& val : view_test | std::views::drop(2) | std::views::take(4) | std::views::reverse) {
+            std::cout << val << " ";
+        }
+        std::cout << " (Expected: 5 4 3 2)\n";
+        
+        for (auto& val : view_test.view_slice(0, 10, 3)) {
+            val = -val;
+        }
+        print_test_result("Write through view_slice(0, 10, 3)", view_test, "0 1 2 -3 4 5 -6 7 8 -9");
+        
+        separator("17. Hash Index Tests");
+        
+        ListOperationsKit<int> indexed = {1, 2, 3, 2, 4, 2, 5};
+        indexed.enable_index();
+        std::cout << "has_index(): " << (indexed.has_index() ? "Yes" : "No") << " (Expected: Yes)\n";
+        std::cout << "count(2): " << indexed.count(2) << " (Expected: 3)\n";
+        std::cout << "contains(9): " << (indexed.contains(9) ? "Yes" : "No") << " (Expected: No)\n";
+        
+        indexed.push_front(9);
+        indexed.insert_at(3, 2);
+        indexed.remove(1);
+        indexed.set(0, 7);
+        indexed.pop_back();
+        indexed.sort();
+        indexed.reverse();
+        print_test_result("After mutations", indexed, "7 4 3 2 2 2 2");
+        std::cout << "count(2): " << indexed.count(2) << " (Expected: 4)\n";
+        std::cout << "contains(9): " << (indexed.contains(9) ? "Yes" : "No") << " (Expected: No)\n";
+        std::cout << "contains(5): " << (indexed.contains(5) ? "Yes" : "No") << " (Expected: No)\n";
+        std::cout << "index(3): " << indexed.index(3) << " (Expected: 2)\n";
+        std::cout << "find_index(5): " << (indexed.find_index(5) == std::numeric_limits<size_t>::max() ? "Not found" : "Found")
+                  << " (Expected: Not found)\n";
+        
+        indexed[0] = 5;
+        indexed.rebuild_index();
+        std::cout << "count(5) after operator[] write + rebuild_index(): " << indexed.count(5) << " (Expected: 1)\n";
+        
+        indexed.disable_index();
+        std::cout << "count(2) without index: " << indexed.count(2) << " (Expected: 4)\n";
+        
+        separator("18. Shared Snapshot Tests");
+        
+        SharedListOperationsKit<int> shared = {1, 2, 3, 4, 5};
+        auto snap = shared.snapshot();
+        shared.push_back(6);
+        shared.push_front(0);
+        shared.set(3, 30);
+        shared.remove(1);
+        shared.insert_at(2, 25);
+        std::cout << "Modified: " << shared << " (Expected: 0 2 25 30 4 5 6)\n";
+        std::cout << "Snapshot: " << snap << " (Expected: 1 2 3 4 5)\n";
+        std::cout << "get(3): " << shared.get(3) << " (Expected: 30)\n";
+        std::cout << "front/back: " << shared.front() << " " << shared.back() << " (Expected: 0 6)\n";
+        
+        SharedListOperationsKit<int> from_list(list7);
+        std::cout << "From ListOperationsKit: " << from_list << " (Expected: 10 20 30 40 50)\n";
+        
+        SharedListOperationsKit<int> big;
+        for (int i = 0; i < 1000; ++i) {
+            big.push_back(i);
+        }
+        auto frozen = big.snapshot();
+        std::vector<long long> reader_sums(4, 0);
+        std::vector<std::thread> readers;
+        for (size_t r = 0; r < reader_sums.size(); ++r) {
+            readers.emplace_back([view = frozen.snapshot(), &reader_sums, r]() {
+                for (const auto& val : view) {
+                    reader_sums[r] += val;
+                }
+            });
+        }
+        for (int i = 0; i < 1000; ++i) {
+            big.pop_front();
+        }
+        for (auto& reader : readers) {
+            reader.join();
+        }
+        std::cout << "Concurrent reader sums: ";
+        for (auto sum : reader_sums) {
+            std::cout << sum << " ";
+        }
+        std::cout << "(Expected: 499500 x4)\n";
+        std::cout << "Writer size after pops: " << big.size() << " (Expected: 0)\n";
+        
+        auto back_to_list = shared.to_list();
+        print_test_result("to_list()", back_to_list, "0 2 25 30 4 5 6");
+        
+        separator("19. Small Buffer Tests");
+        
+        SmallListOperationsKit<int, 4> small = {1, 2, 3};
+        small.push_front(0);
+        print_test_result("Inline (4 slots)", small, "0 1 2 3");
+        small.append(4, 5);
+        print_test_result("Overflow to heap", small, "0 1 2 3 4 5");
+        small.remove(1);
+        small.pop_front();
+        small.insert_at(1, 9);
+        print_test_result("Slot reuse", small, "2 9 3 4 5");
+        
+        std::cout << "Reverse iteration: ";
+        for (auto it = small.rbegin(); it != small.rend(); ++it) {
+            std::cout << *it << " ";
+        }
+        std::cout << " (Expected: 5 4 3 9 2)\n";
+        
+        SmallListOperationsKit<int, 4> small_copy = small;
+        SmallListOperationsKit<int, 4> small_moved = std::move(small);
+        small_moved.sort();
+        print_test_result("Copy", small_copy, "2 9 3 4 5");
+        print_test_result("Move + sort", small_moved, "2 3 4 5 9");
+        std::cout << "Moved-from empty: " << (small.empty() ? "Yes" : "No") << "\n";
+        small_moved.concatenate(SmallListOperationsKit<int, 4>{7, 8});
+        print_test_result("Concatenate (small storage)", small_moved, "2 3 4 5 9 7 8");
+        
+        SmallListOperationsKit<std::string> small_strings = {"short", "lived"};
+        small_strings.emplace_back(3, '!');
+        print_test_result("Small string list", small_strings, "short lived !!!");
+        
+        separator("20. Node Layout Tests");
+        
+        CacheAlignedListOperationsKit<int> aligned = {3, 1, 2};
+        aligned.push_front(0);
+        aligned.sort();
+        print_test_result("Cache-aligned list", aligned, "0 1 2 3");
+        std::cout << "Node size/alignment: " << sizeof(CacheAlignedListOperationsKit<int>::node_type) << "/"
+                  << alignof(CacheAlignedListOperationsKit<int>::node_type) << " (Expected: 64/64)\n";
+        std::cout << "Node address aligned: "
+                  << (reinterpret_cast<uintptr_t>(&aligned.front()) % cache_line_size == offsetof(CacheAlignedListOperationsKit<int>::node_type, element) ? "Yes" : "No")
+                  << "\n";
+        std::cout << "to_string(): \"" << aligned.to_string() << "\" (Expected: \"0 1 2 3\")\n";
+        std::cout << "count(2)/index(3): " << aligned.count(2) << "/" << aligned.index(3) << " (Expected: 1/3)\n";
+        
+        separator("21. Compaction Tests");
+        
+        auto nodes_contiguous = [](const auto& list) {
+            const void* previous = nullptr;
+            for (const auto& item : list) {
+                auto current = reinterpret_cast<const char*>(&item);
+                if (previous && current - static_cast<const char*>(previous) != static_cast<std::ptrdiff_t>(sizeof(DoublyChainNode<int>))) {
+                    return false;
+                }
+                previous = current;
+            }
+            return true;
+        };
+        
+        ListOperationsKit<int> churned;
+        for (int i = 0; i < 8; ++i) {
+            churned.push_front(i);
+            churned.insert_at(churned.size() / 2, 100 + i);
+        }
+        churned.remove(3);
+        churned.sort();
+        auto before_compact = churned.to_string();
+        churned.compact();
+        std::cout << "Order preserved by compact(): " << (churned.to_string() == before_compact ? "Yes" : "No") << "\n";
+        std::cout << "Nodes contiguous after compact(): " << (nodes_contiguous(churned) ? "Yes" : "No") << "\n";
+        std::cout << "back() after compact(): " << churned.back() << " (Expected: 107)\n";
+        churned.remove(2);
+        churned.push_back(200);
+        churned.pop_front();
+        print_test_result("Mutations after compact()", churned, "1 3 5 6 7 100 101 102 103 104 105 106 107 200");
+        
+        ListOperationsKit<int> auto_compacted;
+        auto_compacted.set_auto_compact(1.0);
+        for (int i = 0; i < 100; ++i) {
+            auto_compacted.push_back(i);
+            auto_compacted.push_front(-i);
+        }
+        for (int i = 0; i < 50; ++i) {
+            auto_compacted.pop_front();
+        }
+        std::cout << "Auto compaction size/front/back: " << auto_compacted.size() << "/" << auto_compacted.front()
+                  << "/" << auto_compacted.back() << " (Expected: 150/-49/99)\n";
+        
+        ListOperationsKit<int> moved_compacted = std::move(churned);
+        moved_compacted.clear();
+        std::cout << "Compacted list moved and cleared: " << (moved_compacted.empty() && churned.empty() ? "Yes" : "No") << "\n";
+        
+        struct FragileCopy {
+            int value;
+            int* copies_left;
+            FragileCopy(int v, int* budget) : value(v), copies_left(budget) {}
+            FragileCopy(const FragileCopy& other) : value(other.value), copies_left(other.copies_left) {
+                if ((*copies_left)-- == 0) throw std::runtime_error("copy failed");
+            }
+            FragileCopy& operator=(const FragileCopy&) = default;
+        };
+        
+        int copy_budget = -1;
+        ListOperationsKit<FragileCopy> fragile;
+        for (int i = 0; i < 5; ++i) {
+            fragile.emplace_back(i, &copy_budget);
+        }
+        copy_budget = 2;
+        try {
+            fragile.compact();
+        } catch (const std::runtime_error&) {
+            std::cout << "compact() rethrows copy failure\n";
+        }
+        int fragile_sum = 0;
+        for (const auto& item : fragile) {
+            fragile_sum += item.value;
+        }
+        std::cout << "List intact after failed compact(): " << fragile.size() << "/" << fragile_sum << " (Expected: 5/10)\n";
+        copy_budget = -1;
+        fragile.pop_front();
+        fragile.pop_front();
+        fragile.compact();
+        std::cout << "Partial block released and recompacted: " << (fragile.size() == 3 && fragile.front().value == 2 ? "Yes" : "No") << "\n";
+        
+        separator("22. Radix Sort Tests");
+        
+        auto matches_std_sort = [](auto list, bool descending) {
+            using value_t = typename decltype(list)::value_type;
+            std::vector<value_t> expected(list.begin(), list.end());
+            if (descending) {
+                std::sort(expected.begin(), expected.end(), std::greater<value_t>());
+            } else {
+                std::sort(expected.begin(), expected.end());
+            }
+            list.sort(descending);
+            return std::equal(expected.begin(), expected.end(), list.begin());
+        };
+        
+        std::mt19937_64 radix_rng(7);
+        ListOperationsKit<int64_t> signed_values;
+        ListOperationsKit<uint64_t> unsigned_values;
+        ListOperationsKit<double> double_values;
+        ListOperationsKit<float> float_values;
+        ListOperationsKit<int8_t> byte_values;
+        for (int i = 0; i < 5000; ++i) {
+            signed_values.push_back(static_cast<int64_t>(radix_rng()));
+            unsigned_values.push_back(radix_rng() >> (i % 64));
+            double_values.push_back(std::uniform_real_distribution<double>(-1e6, 1e6)(radix_rng));
+            float_values.push_back(std::uniform_real_distribution<float>(-10.0f, 10.0f)(radix_rng));
+            byte_values.push_back(static_cast<int8_t>(radix_rng()));
+        }
+        double_values.append(0.0, -0.0, std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity());
+        
+        for (bool descending : {false, true}) {
+            std::cout << (descending ? "Descending" : "Ascending") << " radix sort matches std::sort: "
+                      << (matches_std_sort(signed_values, descending) && matches_std_sort(unsigned_values, descending) &&
+                          matches_std_sort(double_values, descending) && matches_std_sort(float_values, descending) &&
+                          matches_std_sort(byte_values, descending) ? "Yes" : "No") << "\n";
+        }
+        
+        struct Event {
+            uint32_t timestamp;
+            std::string name;
+        };
+        ListOperationsKit<Event> events;
+        for (int i = 0; i < 300; ++i) {
+            events.push_back(Event{static_cast<uint32_t>((i * 37) % 100), "e" + std::to_string(i)});
+        }
+        events.sort_by_key([](const Event& e) { return e.timestamp; });
+        bool by_key_sorted = true;
+        bool by_key_stable = true;
+        const Event* previous_event = nullptr;
+        for (const auto& event : events) {
+            if (previous_event) {
+                by_key_sorted = by_key_sorted && previous_event->timestamp <= event.timestamp;
+                if (previous_event->timestamp == event.timestamp) {
+                    by_key_stable = by_key_stable && std::stoi(previous_event->name.substr(1)) < std::stoi(event.name.substr(1));
+                }
+            }
+            previous_event = &event;
+        }
+        std::cout << "sort_by_key sorted/stable: " << (by_key_sorted ? "Yes" : "No") << "/" << (by_key_stable ? "Yes" : "No") << "\n";
+        events.sort_by_key([](const Event& e) { return e.timestamp; }, true);
+        std::cout << "sort_by_key descending front/back: " << events.front().timestamp << "/" << events.back().timestamp
+                  << " (Expected: 99/0)\n";
+        
+        ListOperationsKit<int> small_radix = {3, -1, 2};
+        small_radix.sort_by_key([](int x) { return x; });
+        print_test_result("sort_by_key on ints", small_radix, "-1 2 3");
+        
+        separator("23. Bulk Erase and Set Operation Tests");
+        
+        ListOperationsKit<int> bulk = {1, 2, 2, 3, 4, 4, 4, 5, 6, 6};
+        bulk.enable_index();
+        std::cout << "erase_if(odd) removed: " << bulk.erase_if([](int x) { return x % 2 != 0; }) << " (Expected: 3)\n";
+        print_test_result("After erase_if", bulk, "2 2 4 4 4 6 6");
+        std::cout << "unique() removed: " << bulk.unique() << " (Expected: 4)\n";
+        print_test_result("After unique", bulk, "2 4 6");
+        std::cout << "remove_value(4) removed: " << bulk.remove_value(4) << " (Expected: 1)\n";
+        std::cout << "Index after bulk ops count(4)/count(2): " << bulk.count(4) << "/" << bulk.count(2) << " (Expected: 0/1)\n";
+        
+        ListOperationsKit<int> merge_a = {1, 3, 5, 7};
+        ListOperationsKit<int> merge_b = {2, 3, 6, 8, 9};
+        merge_a.merge(merge_b);
+        print_test_result("merge", merge_a, "1 2 3 3 5 6 7 8 9");
+        std::cout << "Merged-from list empty: " << (merge_b.empty() ? "Yes" : "No") << "\n";
+        
+        ListOperationsKit<int> union_a = {1, 2, 2, 4, 7};
+        ListOperationsKit<int> union_b = {2, 3, 4, 4, 8};
+        union_a.set_union(union_b);
+        print_test_result("set_union", union_a, "1 2 2 3 4 4 7 8");
+        std::cout << "back() after set_union: " << union_a.back() << " (Expected: 8)\n";
+        
+        ListOperationsKit<int> inter_a = {1, 2, 2, 3, 4, 4, 9};
+        ListOperationsKit<int> inter_b = {2, 4, 4, 4, 5, 9};
+        inter_a.set_intersection(inter_b);
+        print_test_result("set_intersection", inter_a, "2 4 4 9");
+        
+        ListOperationsKit<int> diff_a = {1, 2, 2, 3, 4, 5};
+        ListOperationsKit<int> diff_b = {2, 3, 3, 5, 6};
+        diff_a.set_difference(diff_b);
+        print_test_result("set_difference", diff_a, "1 2 4");
+        
+        ListOperationsKit<int> desc_a = {9, 5, 1};
+        desc_a.merge(ListOperationsKit<int>{8, 4}, std::greater<int>());
+        print_test_result("merge with std::greater", desc_a, "9 8 5 4 1");
+        
+        ListOperationsKit<int> compacted_source = {1, 4, 6};
+        compacted_source.compact();
+        ListOperationsKit<int> compacted_target = {2, 3, 5};
+        compacted_target.merge(compacted_source);
+        compacted_source.push_back(10);
+        print_test_result("merge from compacted list", compacted_target, "1 2 3 4 5 6");
+        
+        SmallListOperationsKit<int, 2> small_a = {1, 3, 5};
+        SmallListOperationsKit<int, 2> small_b = {2, 4};
+        small_a.merge(small_b);
+        print_test_result("merge small lists", small_a, "1 2 3 4 5");
+        
+        for (bool compacted : {false, true}) {
+            ListOperationsKit<int> flaky_target = {1, 5, 9};
+            flaky_target.enable_index<FlakyHash>();
+            ListOperationsKit<int> flaky_source = {2, 3, 4};
+            if (compacted) flaky_source.compact();
+            FlakyHash::calls_left = 1;
+            try {
+                flaky_target.merge(flaky_source);
+            } catch (const std::bad_alloc&) {
+                std::cout << "merge() rethrows index failure" << (compacted ? " (compacted source)" : "") << "\n";
+            }
+            FlakyHash::calls_left = -1;
+            bool intact = flaky_target.size() + flaky_source.size() == 6;
+            for (int value = 1; value <= 9; ++value) {
+                const size_t held = flaky_target.count(value) + flaky_source.count(value);
+                const bool expected = value <= 5 || value == 9;
+                intact = intact && held == (expected ? 1u : 0u) && flaky_target.contains(value) == (flaky_target.find_index(value) != SIZE_MAX);
+            }
+            print_test_result("Target after failed merge", flaky_target, "1 2 5 9");
+            std::cout << "No element lost and index consistent: " << (intact ? "Yes" : "No") << " (Expected: Yes)\n";
+        }
+        
+        separator("24. Batched Positional Operation Tests");
+        
+        ListOperationsKit<int> batch = {10, 20, 30, 40, 50, 60, 70, 80};
+        batch.enable_index();
+        std::vector<size_t> picks = {6, 1, 6, 3};
+        std::cout << "get_many({6, 1, 6, 3}): ";
+        for (int& value : batch.get_many(picks)) {
+            std::cout << value << " ";
+        }
+        std::cout << "  (Expected: 70 20 70 40)\n";
+        
+        std::vector<int> picked(picks.size());
+        batch.get_many(picks, picked);
+        std::cout << "get_many into span: " << picked[0] << " " << picked[1] << " " << picked[2] << " " << picked[3]
+                  << " (Expected: 70 20 70 40)\n";
+        
+        batch.get_many(std::vector<size_t>{0})[0].get() = 11;
+        print_test_result("Write through get_many reference", batch, "11 20 30 40 50 60 70 80");
+        
+        std::vector<size_t> set_positions = {7, 2};
+        std::vector<int> set_values = {88, 33};
+        batch.set_many(set_positions, set_values);
+        print_test_result("set_many({7, 2})", batch, "11 20 33 40 50 60 70 88");
+        std::cout << "Index after set_many contains(30)/contains(88): " << batch.contains(30) << "/" << batch.contains(88)
+                  << " (Expected: 0/1)\n";
+        
+        std::vector<size_t> remove_positions = {5, 0, 5, 7};
+        std::cout << "remove_many({5, 0, 5, 7}) removed: " << batch.remove_many(remove_positions) << " (Expected: 3)\n";
+        print_test_result("After remove_many", batch, "20 33 40 50 70");
+        
+        std::vector<size_t> insert_positions = {5, 0, 2, 2};
+        std::vector<int> insert_values = {99, 1, 34, 35};
+        batch.insert_many(insert_positions, insert_values);
+        print_test_result("insert_many({5, 0, 2, 2})", batch, "1 20 33 34 35 40 50 70 99");
+        std::cout << "back() after insert_many: " << batch.back() << " (Expected: 99)\n";
+        
+        try {
+            std::vector<size_t> bad_positions = {1, 9};
+            batch.remove_many(bad_positions);
+        } catch (const std::out_of_range&) {
+            std::cout << "remove_many out of range throws before removing, size: " << batch.size() << " (Expected: 9)\n";
+        }
+        
+        separator("25. Work-Stealing Deque Tests");
+        
+        WorkStealingDeque<std::string> ws_deque(2);
+        ::stack<std::string>& ws_stack = ws_deque;
+        ws_stack.push("a");
+        ws_stack.push("b");
+        ws_stack.push("c");
+        ws_deque.emplace(3, 'd');
+        std::cout << "Size after growing past capacity 2: " << ws_stack.size() << " (Expected: 4)\n";
+        std::cout << "top(): " << ws_stack.top() << " (Expected: ddd)\n";
+        std::cout << "steal(): " << ws_deque.steal().value_or("-") << " (Expected: a)\n";
+        ws_stack.pop();
+        std::cout << "try_pop() after pop(): " << ws_deque.try_pop().value_or("-") << " (Expected: c)\n";
+        std::cout << "steal(): " << ws_deque.steal().value_or("-") << " (Expected: b)\n";
+        std::cout << "try_pop()/steal() on empty: " << ws_deque.try_pop().value_or("-") << "/"
+                  << ws_deque.steal().value_or("-") << " (Expected: -/-)\n";
+        try {
+            ws_stack.pop();
+        } catch (const std::runtime_error&) {
+            std::cout << "pop() on empty deque throws\n";
+        }
+        
+        WorkStealingDeque<uint64_t> contended;
+        std::atomic<uint64_t> stolen_sum(0);
+        std::atomic<size_t> stolen_count(0);
+        std::atomic<bool> owner_done(false);
+        std::vector<std::thread> thieves;
+        for (int i = 0; i < 3; ++i) {
+            thieves.emplace_back([&] {
+                while (!owner_done.load() || !contended.empty()) {
+                    if (std::optional<uint64_t> value = contended.steal()) {
+                        stolen_sum += *value;
+                        ++stolen_count;
+                    }
+                }
+            });
+        }
+        uint64_t owned_sum = 0;
+        size_t owned_count = 0;
+        for (uint64_t i = 1; i <= 100000; ++i) {
+            contended.push(i);
+            if (i % 3 == 0) {
+                if (std::optional<uint64_t> value = contended.try_pop()) {
+                    owned_sum += *value;
+                    ++owned_count;
+                }
+            }
+        }
+        owner_done.store(true);
+        for (auto& thief : thieves) {
+            thief.join();
+        }
+        std::cout << "Every element taken exactly once under contention: "
+                  << (owned_count + stolen_count == 100000 && owned_sum + stolen_sum == 5000050000ULL ? "Yes" : "No") << "\n";
+        
+        WorkStealingThreadPool pool(4);
+        std::cout << "Fork-join sum of [0, 1000000): "
+                  << pool.submit([&] { return parallel_range_sum(pool, 0, 1000000); }).get()
+                  << " (Expected: 499999500000)\n";
+        
+        std::atomic<int> invoked(0);
+        pool.invoke([&] { ++invoked; }, [&] { ++invoked; });
+        std::cout << "invoke() from outside the pool ran both: " << invoked.load() << " (Expected: 2)\n";
+        
+        try {
+            pool.invoke([] {}, [] { throw std::runtime_error("task failed"); });
+        } catch (const std::runtime_error& e) {
+            std::cout << "invoke() rethrows: " << e.what() << "\n";
+        }
+        
+        separator("26. Async Queue Tests");
+        
+        SingleThreadedScheduler loop;
+        AsyncLinkedQueue<int> idle_queue(std::numeric_limits<size_t>::max(), &loop);
+        long long idle_sum = 0;
+        int idle_finished = 0;
+        for (int i = 0; i < 10000; ++i) {
+            consume_one(idle_queue, idle_sum, idle_finished).spawn(loop);
+        }
+        loop.run();
+        std::cout << "10000 consumers suspended, finished: " << idle_finished << " (Expected: 0)\n";
+        int idle_pushed = 0;
+        produce_range(idle_queue, 1, 10000, idle_pushed).spawn(loop);
+        loop.run();
+        std::cout << "After producing 10000 values, finished/sum: " << idle_finished << "/" << idle_sum
+                  << " (Expected: 10000/50005000)\n";
+        
+        AsyncLinkedQueue<int> bounded(2, &loop);
+        int bounded_pushed = 0;
+        produce_range(bounded, 1, 5, bounded_pushed).spawn(loop);
+        loop.run();
+        std::cout << "Producer blocked on full queue after: " << bounded_pushed << " (Expected: 2)\n";
+        std::vector<int> popped_batch;
+        consume_batch(bounded, 10, popped_batch).spawn(loop);
+        loop.run();
+        std::cout << "pop_up_to(10): ";
+        for (int value : popped_batch) {
+            std::cout << value << " ";
+        }
+        std::cout << " (Expected: 1 2 3)\n";
+        std::cout << "Producer finished, queued: " << bounded_pushed << "/" << bounded.size() << " (Expected: 5/2)\n";
+        
+        AsyncLinkedQueue<int> inline_queue;
+        long long inline_sum = 0;
+        int inline_finished = 0;
+        consume_one(inline_queue, inline_sum, inline_finished).spawn(loop);
+        loop.run();
+        inline_queue.try_push(42);
+        std::cout << "try_push resumes waiting consumer inline: " << inline_sum << " (Expected: 42)\n";
+        
+        AsyncLinkedQueue<int> closing(std::numeric_limits<size_t>::max(), &loop);
+        long long closing_sum = 0;
+        int closing_finished = 0;
+        consume_one(closing, closing_sum, closing_finished).spawn(loop);
+        loop.run();
+        closing.close();
+        loop.run();
+        std::cout << "close() releases consumer: " << closing_finished << ", try_push after close: "
+                  << (closing.try_push(1) ? "accepted" : "rejected") << " (Expected: 1, rejected)\n";
+        
+        {
+            MultiThreadedScheduler workers(4);
+            AsyncLinkedQueue<int> shared(64, &workers);
+            std::atomic<long long> shared_sum(0);
+            std::atomic<int> shared_received(0);
+            std::latch producers_done(4);
+            std::latch consumers_done(8);
+            for (int i = 0; i < 8; ++i) {
+                consume_until_closed(shared, shared_sum, shared_received, consumers_done).spawn(workers);
+            }
+            for (int i = 0; i < 4; ++i) {
+                produce_concurrently(shared, 5000, producers_done).spawn(workers);
+            }
+            producers_done.wait();
+            shared.close();
+            consumers_done.wait();
+            std::cout << "4 producers x 5000 to 8 consumers on 4 threads, received/sum: " << shared_received.load()
+                      << "/" << shared_sum.load() << " (Expected: 20000/50010000)\n";
+        }
+        
+        separator("27. Concurrent Sorted List Tests");
+        
+        LockFreeSortedList<int> lock_free;
+        std::cout << "insert 5, 1, 9, 5: " << lock_free.insert(5) << lock_free.insert(1) << lock_free.insert(9)
+                  << lock_free.insert(5) << " (Expected: 1110)\n";
+        std::cout << "LockFreeSortedList contents: " << concurrent_list_contents(lock_free) << " (Expected: 1 5 9 )\n";
+        std::cout << "erase 5, erase 7, contains 5/9: " << lock_free.erase(5) << lock_free.erase(7) << " "
+                  << lock_free.contains(5) << "/" << lock_free.contains(9) << " (Expected: 10 0/1)\n";
+        std::cout << "size: " << lock_free.size() << " (Expected: 2)\n";
+        
+        LazySortedList<int, std::greater<int>> lazy;
+        lazy.insert(2);
+        lazy.insert(8);
+        lazy.insert(4);
+        lazy.erase(8);
+        std::cout << "LazySortedList<std::greater> contents: " << concurrent_list_contents(lazy) << " (Expected: 4 2 )\n";
+        
+        std::cout << "LockFreeSortedList 4-thread insert/erase stress consistent: "
+                  << (concurrent_list_stress<LockFreeSortedList<int>>() ? "Yes" : "No") << "\n";
+        std::cout << "LazySortedList 4-thread insert/erase stress consistent: "
+                  << (concurrent_list_stress<LazySortedList<int>>() ? "Yes" : "No") << "\n";
+        
+        separator("28. Lazy Reverse, Rotate and Shuffle Tests");
+        
+        ListOperationsKit<int> flip = {1, 2, 3, 4, 5};
+        flip.reverse();
+        print_test_result("reverse() (flag)", flip, "5 4 3 2 1");
+        std::cout << "front/back/[1]/get(3): " << flip.front() << "/" << flip.back() << "/" << flip[1] << "/" << flip.get(3)
+                  << " (Expected: 5/1/4/2)\n";
+        flip.push_front(6);
+        flip.push_back(0);
+        flip.insert_at(3, 99);
+        print_test_result("push_front/push_back/insert_at on reversed", flip, "6 5 4 99 3 2 1 0");
+        flip.remove(3);
+        flip.pop_front();
+        flip.pop_back();
+        print_test_result("remove/pop_front/pop_back on reversed", flip, "5 4 3 2 1");
+        std::cout << "Reverse iteration: ";
+        for (auto it = flip.rbegin(); it != flip.rend(); ++it) {
+            std::cout << *it << " ";
+        }
+        std::cout << " (Expected: 1 2 3 4 5)\n";
+        std::cout << "find_index(2)/to_string(): " << flip.find_index(2) << "/" << flip.to_string() << " (Expected: 3/5 4 3 2 1)\n";
+        ListOperationsKit<int> flip_forward = {5, 4, 3, 2, 1};
+        std::cout << "Reversed list == forward-built list: " << (flip == flip_forward ? "Yes" : "No") << "\n";
+        
+        ListOperationsKit<int> flip_other = {2, 4, 6};
+        flip_other.reverse();
+        flip.merge(flip_other, std::greater<int>());
+        print_test_result("merge two reversed lists", flip, "6 5 4 4 3 2 2 1");
+        
+        auto flip_first = flip.begin();
+        ListOperationsKit<int> flip_moved(std::move(flip));
+        print_test_result("Move keeps direction", flip_moved, "6 5 4 4 3 2 2 1");
+        std::cout << "Iterator taken before move: ";
+        for (auto it = flip_first; it != flip_moved.end(); ++it) {
+            std::cout << *it << " ";
+        }
+        std::cout << " (Expected: 6 5 4 4 3 2 2 1)\n";
+        auto flip_third = std::next(flip_first, 2);
+        std::cout << "Step back after move: " << *std::prev(flip_third) << " (Expected: 5)\n";
+        ListOperationsKit<int> flip_live = {1, 2, 3, 4};
+        auto flip_live_it = flip_live.begin();
+        flip_live.reverse();
+        ++flip_live_it;
+        std::cout << "Iterator taken before reverse() keeps its direction: " << *flip_live_it << ", fresh begin(): "
+                  << *flip_live.begin() << " (Expected: 2, fresh begin(): 4)\n";
+        flip_moved.reverse();
+        print_test_result("reverse() twice", flip_moved, "1 2 2 3 4 4 5 6");
+        
+        ListOperationsKit<int> flip_large;
+        for (int i = 0; i < 300; ++i) {
+            flip_large.push_back((i * 37) % 300);
+        }
+        flip_large.reverse();
+        flip_large.sort();
+        flip_large.compact();
+        std::cout << "Radix sort + compact on reversed list, front/back/[150]: " << flip_large.front() << "/"
+                  << flip_large.back() << "/" << flip_large[150] << " (Expected: 0/299/150)\n";
+        
+        ListOperationsKit<int> ring = {1, 2, 3, 4, 5, 6};
+        ring.rotate(2);
+        print_test_result("rotate(2)", ring, "3 4 5 6 1 2");
+        ring.rotate(-3);
+        print_test_result("rotate(-3)", ring, "6 1 2 3 4 5");
+        ring.rotate(13);
+        print_test_result("rotate(13)", ring, "1 2 3 4 5 6");
+        ring.reverse();
+        ring.rotate(1);
+        print_test_result("rotate(1) on reversed", ring, "5 4 3 2 1 6");
+        std::cout << "back() after rotate: " << ring.back() << " (Expected: 6)\n";
+        
+        ListOperationsKit<int> deck;
+        for (int i = 0; i < 52; ++i) {
+            deck.push_back(i);
+        }
+        int* ace = &deck.front();
+        std::mt19937 shuffle_rng(2024);
+        deck.shuffle(shuffle_rng);
+        ListOperationsKit<int> sorted_deck = deck;
+        sorted_deck.sort();
+        bool same_cards = true;
+        for (int i = 0; i < 52; ++i) {
+            same_cards = same_cards && sorted_deck[i] == i;
+        }
+        std::cout << "shuffle() keeps all 52 cards: " << (same_cards ? "Yes" : "No")
+                  << ", changed order: " << (deck != sorted_deck ? "Yes" : "No")
+                  << ", references stay valid: " << (*ace == 0 && deck[deck.find_index(0)] == *ace ? "Yes" : "No") << "\n";
+        
+        separator("29. Memory Resource (pmr) Tests");
+        
+        std::array<std::byte, 16384> arena_buffer;
+        CountingArena arena(arena_buffer.data(), arena_buffer.size(), std::pmr::null_memory_resource());
+        {
+            PmrListOperationsKit<int> scoped(&arena);
+            scoped.append(3, 1, 2);
+            scoped.insert_at(1, 7);
+            scoped.sort();
+            print_test_result("List on monotonic arena", scoped, "1 2 3 7");
+            std::cout << "Nodes allocated from arena: " << arena.allocations
+                      << ", uses arena: " << (scoped.get_memory_resource() == &arena ? "Yes" : "No") << " (Expected: 4, Yes)\n";
+            scoped.remove(0);
+            size_t frees_before_clear = arena.deallocations;
+            scoped.clear();
+            std::cout << "clear() frees per node on arena: " << (arena.deallocations - frees_before_clear)
+                      << ", empty: " << (scoped.empty() ? "Yes" : "No") << " (Expected: 0, Yes)\n";
+            scoped.push_back(9);
+            print_test_result("Reuse after clear()", scoped, "9");
+            
+            PmrListOperationsKit<int> copied = scoped;
+            std::cout << "Copy uses default resource: " << (copied.get_memory_resource() == std::pmr::get_default_resource() ? "Yes" : "No")
+                      << " (Expected: Yes)\n";
+            
+            PmrLinkedQueue<int> arena_queue(&arena);
+            PmrLinkedStack<int> arena_stack(&arena);
+            for (int i = 1; i <= 100; ++i) {
+                arena_queue.push(i);
+                arena_stack.push(i);
+            }
+            arena_queue.pop();
+            arena_stack.pop();
+            std::cout << "Arena queue front/back, stack top: " << arena_queue.front() << "/" << arena_queue.back()
+                      << ", " << arena_stack.top() << " (Expected: 2/100, 99)\n";
+        }
+        std::cout << "Frees reaching arena (one per remove/pop, none per destroyed node): " << arena.deallocations
+                  << " (Expected: 3)\n";
+        
+        size_t frees_before_strings = arena.deallocations;
+        {
+            PmrListOperationsKit<std::string> names({"alpha", "beta", "gamma"}, &arena);
+            print_test_result("Non-trivial elements on arena", names, "alpha beta gamma");
+        }
+        std::cout << "std::string nodes still destroyed one by one: " << (arena.deallocations - frees_before_strings)
+                  << " (Expected: 3)\n";
+        arena.release();
+        
+        std::pmr::unsynchronized_pool_resource node_pool;
+        PmrListOperationsKit<int> pooled({5, 6}, &node_pool);
+        PmrListOperationsKit<int> other_pool({1, 8}, std::pmr::new_delete_resource());
+        pooled.merge(other_pool);
+        print_test_result("merge across resources", pooled, "1 5 6 8");
+        std::cout << "Source emptied: " << (other_pool.empty() ? "Yes" : "No") << " (Expected: Yes)\n";
+        pooled.concatenate(PmrListOperationsKit<int>({2, 3}, &node_pool));
+        print_test_result("concatenate (pmr storage)", pooled, "1 5 6 8 2 3");
+        
+        separator("30. Columnar List Tests");
+        
+        ColumnarListOperationsKit<int, int64_t, double> records = {{3, 300, 1.5}, {1, 100, 2.5}};
+        records.append(2, 200, 0.5);
+        records.insert_at(1, 4, 400, 4.0);
+        std::cout << "Rows: " << records << " (Expected: (3, 300, 1.5) (4, 400, 4) (1, 100, 2.5) (2, 200, 0.5))\n";
+        std::cout << "get<0>(2)/get(3): " << records.get<0>(2) << "/" << std::get<2>(records.get(3))
+                  << " (Expected: 1/0.5)\n";
+        records.sort<0>();
+        std::cout << "sort<0>(): " << records.to_string() << " (Expected: (1, 100, 2.5) (2, 200, 0.5) (3, 300, 1.5) (4, 400, 4))\n";
+        records.sort<2>(true);
+        std::cout << "sort<2>(descending) ids: ";
+        for (int id : records.column_values<0>()) {
+            std::cout << id << " ";
+        }
+        std::cout << " (Expected: 4 1 3 2)\n";
+        records.set<1>(0, 450);
+        records.set(3, 5, 500, 5.0);
+        records.remove(1);
+        std::cout << "set/remove: " << records << " (Expected: (4, 450, 4) (3, 300, 1.5) (5, 500, 5))\n";
+        std::cout << "sum<1>/min<2>/max<0>: " << records.sum<1>() << "/" << records.min<2>() << "/" << records.max<0>()
+                  << " (Expected: 1250/1.5/5)\n";
+        
+        ColumnarListOperationsKit<uint32_t, uint64_t> columnar_events;
+        for (uint32_t i = 0; i < 5000; ++i) {
+            columnar_events.push_back(i, uint64_t(i) * 2);
+        }
+        columnar_events.insert_at(10, 99999, 1);
+        columnar_events.insert_at(2500, 88888, 1);
+        std::cout << "Chunks after 5000 appends + 2 inserts: " << columnar_events.chunk_count()
+                  << ", rows[10]/[11]/[2500]: " << columnar_events.get<0>(10) << "/" << columnar_events.get<0>(11) << "/" << columnar_events.get<0>(2500)
+                  << " (Expected: 7, 99999/10/88888)\n";
+        while (columnar_events.size() > 40) {
+            columnar_events.remove(columnar_events.size() / 2);
+        }
+        std::cout << "After removing down to 40 rows, chunks: " << columnar_events.chunk_count() << " (Expected: 1)\n";
+        
+        ColumnarListOperationsKit<uint32_t, uint64_t> wide;
+        for (uint32_t i = 0; i < 3000; ++i) {
+            wide.push_back(i, uint64_t(i) * 2);
+        }
+        std::cout << "sum<1>/count_if<0>(even)/reduce<0>(max): " << wide.sum<1>() << "/"
+                  << wide.count_if<0>([](uint32_t v) { return v % 2 == 0; }) << "/"
+                  << wide.reduce<0>(uint32_t(0), [](uint32_t a, uint32_t b) { return std::max(a, b); })
+                  << " (Expected: 8997000/1500/2999)\n";
+        wide.for_each_chunk<1>([](std::span<uint64_t> values) {
+            for (auto& value : values) {
+                value /= 2;
+            }
+        });
+        auto every_thousandth = wide.slice(500, 2600, 1000);
+        std::cout << "for_each_chunk scale + slice(500, 2600, 1000): " << every_thousandth
+                  << " (Expected: (500, 500) (1500, 1500) (2500, 2500))\n";
+        std::cout << "Equal to rebuilt copy: "
+                  << (every_thousandth == ColumnarListOperationsKit<uint32_t, uint64_t>{{500, 500}, {1500, 1500}, {2500, 2500}} ? "Yes" : "No")
+                  << " (Expected: Yes)\n";
+        try {
+            records.get<0>(10);
+        } catch (const std::out_of_range& e) {
+            std::cout << "get<0>(10) out of range: " << e.what() << "\n";
+        }
+        
+        ColumnarListOperationsKit<int, FragileCopy> fragile_rows;
+        copy_budget = -1;
+        fragile_rows.push_back(1, FragileCopy(10, &copy_budget));
+        fragile_rows.push_back(2, FragileCopy(20, &copy_budget));
+        copy_budget = 0;
+        try {
+            fragile_rows.insert_at(1, 3, FragileCopy(30, &copy_budget));
+        } catch (const std::runtime_error&) {
+            std::cout << "insert_at() rethrows copy failure\n";
+        }
+        copy_budget = -1;
+        fragile_rows.push_back(4, FragileCopy(40, &copy_budget));
+        std::cout << "Columns aligned after failed insert: " << fragile_rows.size() << ", ids ";
+        for (int id : fragile_rows.column_values<0>()) {
+            std::cout << id << " ";
+        }
+        std::cout << "values " << fragile_rows.get<1>(1).value << " " << fragile_rows.get<1>(2).value
+                  << " (Expected: 3, ids 1 2 4 values 20 40)\n";
+        
+        separator("31. Top-k, nth_element and Partition Tests");
+        
+        ListOperationsKit<int> scores = {42, 7, 19, 88, 3, 56, 21, 7, 64};
+        print_test_result("top_k(3)", scores.top_k(3), "3 7 7");
+        print_test_result("top_k(4, greater)", scores.top_k(4, std::greater<int>()), "88 64 56 42");
+        print_test_result("top_k(20) (k > size)", scores.top_k(20), "3 7 7 19 21 42 56 64 88");
+        std::cout << "top_k(0) empty: " << (scores.top_k(0).empty() ? "Yes" : "No")
+                  << ", source unchanged: " << scores.to_string() << " (Expected: Yes, 42 7 19 88 3 56 21 7 64)\n";
+        
+        ListOperationsKit<int> median_source = scores;
+        int& median = median_source.nth_element(4);
+        bool split_ok = true;
+        for (size_t i = 0; i < median_source.size(); ++i) {
+            if (i < 4) split_ok = split_ok && median_source[i] <= median;
+            if (i > 4) split_ok = split_ok && median_source[i] >= median;
+        }
+        std::cout << "nth_element(4): " << median << ", partitioned around it: " << (split_ok ? "Yes" : "No")
+                  << " (Expected: 21, Yes)\n";
+        median_source.reverse();
+        std::cout << "nth_element(0, greater) on reversed list: " << median_source.nth_element(0, std::greater<int>())
+                  << ", front: " << median_source.front() << " (Expected: 88, 88)\n";
+        
+        ListOperationsKit<int> mixed = {1, 2, 3, 4, 5, 6, 7, 8};
+        int* four = &mixed[3];
+        auto odds_end = mixed.partition([](int v) { return v % 2 == 1; });
+        print_test_result("partition(odd) stable", mixed, "1 3 5 7 2 4 6 8");
+        std::cout << "Second group starts at: " << *odds_end << ", reference kept: " << (*four == 4 ? "Yes" : "No")
+                  << " (Expected: 2, Yes)\n";
+        mixed.push_back(9);
+        mixed.reverse();
+        mixed.partition([](int v) { return v > 4; });
+        print_test_result("partition(> 4) on reversed list", mixed, "9 8 6 7 5 4 2 3 1");
+        std::cout << "partition(none)/partition(all) end: "
+                  << (mixed.partition([](int) { return false; }) == mixed.begin() ? "begin" : "?") << "/"
+                  << (mixed.partition([](int) { return true; }) == mixed.end() ? "end" : "?") << " (Expected: begin/end)\n";
+        std::cout << "back() after partitions: " << mixed.back() << " (Expected: 1)\n";
+        
+        separator("32. Splice and Sharded Append Tests");
+        
+        ListOperationsKit<int> splice_front = {1, 2, 3};
+        ListOperationsKit<int> splice_back = {4, 5};
+        int* five = &splice_back.back();
+        splice_front.splice(splice_back);
+        print_test_result("splice()", splice_front, "1 2 3 4 5");
+        std::cout << "Source emptied, node kept: " << (splice_back.empty() ? "Yes" : "No") << ", "
+                  << (&splice_front.back() == five ? "Yes" : "No") << " (Expected: Yes, Yes)\n";
+        ListOperationsKit<int> reversed_tail = {8, 7, 6};
+        reversed_tail.reverse();
+        splice_front.reverse();
+        splice_front.splice(ListOperationsKit<int>{0, -1});
+        print_test_result("splice() onto reversed list", splice_front, "5 4 3 2 1 0 -1");
+        splice_front.splice(reversed_tail);
+        print_test_result("splice() of reversed list onto reversed list", splice_front, "5 4 3 2 1 0 -1 6 7 8");
+        splice_front.reverse();
+        print_test_result("reverse() after splices", splice_front, "8 7 6 -1 0 1 2 3 4 5");
+        std::cout << "front/back after splices: " << splice_front.front() << "/" << splice_front.back() << " (Expected: 8/5)\n";
+        SmallListOperationsKit<int, 4> small_source = {9, 10};
+        SmallListOperationsKit<int, 4> small_target = {8};
+        small_target.splice(small_source);
+        print_test_result("splice() of inline nodes (moves elements)", small_target, "8 9 10");
+        
+        ShardedListOperationsKit<int> telemetry;
+        {
+            std::vector<std::thread> producers;
+            for (int t = 0; t < 4; ++t) {
+                producers.emplace_back([&telemetry, t] {
+                    for (int i = 0; i < 1000; ++i) {
+                        telemetry.append(t * 1000 + i);
+                    }
+                });
+            }
+            for (auto& producer : producers) {
+                producer.join();
+            }
+        }
+        std::cout << "Shards/size after 4 threads x 1000 appends: " << telemetry.shard_count() << "/" << telemetry.size()
+                  << " (Expected: 4/4000)\n";
+        ListOperationsKit<int> collected = telemetry.collect();
+        ListOperationsKit<int> drained = telemetry.drain();
+        bool per_thread_order = true;
+        std::vector<int> last_seen(4, -1);
+        for (int value : drained) {
+            per_thread_order = per_thread_order && value % 1000 == last_seen[value / 1000] + 1;
+            last_seen[value / 1000] = value % 1000;
+        }
+        std::cout << "Drained " << drained.size() << ", per-thread order kept: " << (per_thread_order ? "Yes" : "No")
+                  << ", collect() matches: " << (collected == drained ? "Yes" : "No")
+                  << ", empty after drain: " << (telemetry.empty() ? "Yes" : "No") << " (Expected: 4000, Yes, Yes, Yes)\n";
+        telemetry.emplace_back(7);
+        print_test_result("Append after drain", telemetry.drain(), "7");
+        
+        ShardedListOperationsKit<std::string> ordered_log(true);
+        std::thread first_writer([&ordered_log] { ordered_log.append("a"); });
+        first_writer.join();
+        ordered_log.append("b");
+        std::thread second_writer([&ordered_log] { ordered_log.append("c"); });
+        second_writer.join();
+        ordered_log.append("d");
+        std::cout << "Global order collect()/drain(): " << ordered_log.collect() << "/ " << ordered_log.drain()
+                  << " (Expected: a b c d / a b c d)\n";
+        
+        separator("33. Compressed Sorted List Tests");
+        
+        CompressedListOperationsKit<uint64_t> ids = {3, 5, 5, 200, 70000};
+        ids.append(70001, uint64_t(1) << 40);
+        std::cout << "Compressed list: " << ids << " (Expected: 3 5 5 200 70000 70001 1099511627776)\n";
+        std::cout << "front/back/get(3)/[6]: " << ids.front() << "/" << ids.back() << "/" << ids.get(3) << "/" << ids[6]
+                  << " (Expected: 3/1099511627776/200/1099511627776)\n";
+        std::cout << "contains(5)/contains(6)/index(5)/count(5)/find_index(4): " << ids.contains(5) << "/" << ids.contains(6)
+                  << "/" << ids.index(5) << "/" << ids.count(5) << "/"
+                  << (ids.find_index(4) == std::numeric_limits<size_t>::max() ? "npos" : "?") << " (Expected: 1/0/1/2/npos)\n";
+        try {
+            ids.append(10);
+        } catch (const std::invalid_argument& e) {
+            std::cout << "Unsorted append rejected: " << e.what() << "\n";
+        }
+        using compressed_iterator = CompressedListOperationsKit<uint64_t>::const_iterator;
+        auto decoded = ids.begin();
+        uint64_t first_id = *decoded++;
+        std::cout << "Input iterator yielding values: "
+                  << (std::input_iterator<compressed_iterator> && !std::forward_iterator<compressed_iterator> &&
+                      std::is_same_v<std::iter_reference_t<compressed_iterator>, uint64_t> ? "Yes" : "No")
+                  << ", *it++ then *it: " << first_id << " " << *decoded << " (Expected: Yes, *it++ then *it: 3 5)\n";
+        
+        CompressedListOperationsKit<uint64_t> dense;
+        for (uint64_t i = 0; i < 100000; ++i) {
+            dense.append(1'000'000 + i * 3);
+        }
+        std::cout << "100000 dense IDs in " << dense.compressed_bytes() << " bytes"
+                  << ", contains(1000000 + 3 * 77777)/(+1): " << dense.contains(1'000'000 + 3 * 77777) << "/"
+                  << dense.contains(1'000'000 + 3 * 77777 + 1) << " (Expected: 111730 bytes, 1/0)\n";
+        std::cout << "index(1000000 + 3 * 54321)/get(99999): " << dense.index(1'000'000 + 3 * 54321) << "/" << dense.get(99999)
+                  << " (Expected: 54321/1299997)\n";
+        uint64_t decoded_sum = 0;
+        for (uint64_t id : dense) {
+            decoded_sum += id;
+        }
+        std::cout << "Sequential decode sum: " << decoded_sum << " (Expected: 114999850000)\n";
+        auto strided = dense.slice(126, 390, 130);
+        std::cout << "slice(126, 390, 130): " << strided << " (Expected: 1000378 1000768 1001158)\n";
+        
+        CompressedListOperationsKit<uint64_t> evens;
+        CompressedListOperationsKit<uint64_t> threes;
+        for (uint64_t i = 0; i < 3000; ++i) {
+            evens.append(i * 2);
+            threes.append(i * 3);
+        }
+        CompressedListOperationsKit<uint64_t> sixes = evens;
+        sixes.set_intersection(threes);
+        std::cout << "Intersection of evens and multiples of 3: size " << sixes.size() << ", first/last " << sixes.front()
+                  << "/" << sixes.back() << " (Expected: size 1000, first/last 0/5994)\n";
+        CompressedListOperationsKit<uint64_t> sparse = {7, 12, 4000, 5994, 9000};
+        sparse.set_intersection(sixes);
+        std::cout << "Sparse intersection (block skip): " << sparse << " (Expected: 12 5994)\n";
+        CompressedListOperationsKit<int32_t> negatives = {-50, -3, 8};
+        negatives.merge(CompressedListOperationsKit<int32_t>{-7, -3, 100});
+        std::cout << "merge() with signed values: " << negatives.to_string() << " (Expected: -50 -7 -3 -3 8 100)\n";
+        print_test_result("to_list()", negatives.to_list(), "-50 -7 -3 -3 8 100");
+        
+        separator("34. Incremental Aggregate Tests");
+        
+        AggregatingListOperationsKit<int, SumAggregate, MinMaxAggregate> gauges = {5, 3, 9};
+        gauges.push_front(-2);
+        gauges.insert_at(2, 12);
+        std::cout << "sum/min/max/size: " << gauges.sum() << "/" << gauges.min() << "/" << gauges.max() << "/" << gauges.size()
+                  << " (Expected: 27/-2/12/5)\n";
+        gauges.pop_front();
+        gauges.remove(1);
+        std::cout << "After removing both extremes: " << gauges.sum() << "/" << gauges.min() << "/" << gauges.max()
+                  << " (Expected: 17/3/9)\n";
+        gauges.set(0, 40);
+        gauges.erase_if([](int v) { return v == 3; });
+        std::cout << "After set(0, 40) and erase_if(3): " << gauges.sum() << "/" << gauges.min() << "/" << gauges.max()
+                  << " (Expected: 49/9/40)\n";
+        AggregatingListOperationsKit<int, SumAggregate, MinMaxAggregate> more = {100, -100, 1};
+        gauges.splice(more);
+        gauges.sort();
+        std::cout << "After splice() + sort(): " << gauges.sum() << "/" << gauges.min() << "/" << gauges.max()
+                  << ", source sum: " << more.sum() << " (Expected: 50/-100/100, source sum: 0)\n";
+        auto moved_gauges = std::move(gauges);
+        std::cout << "Moved list sum/min, moved-from sum: " << moved_gauges.sum() << "/" << moved_gauges.min() << ", "
+                  << gauges.sum() << " (Expected: 50/-100, 0)\n";
+        moved_gauges.clear();
+        moved_gauges.append(7);
+        std::cout << "After clear() + append(7): " << moved_gauges.sum() << "/" << moved_gauges.min() << "/" << moved_gauges.max()
+                  << " (Expected: 7/7/7)\n";
+        moved_gauges.concatenate(AggregatingListOperationsKit<int, SumAggregate, MinMaxAggregate>{-3, 20});
+        std::cout << "After concatenate({-3, 20}): " << moved_gauges.sum() << "/" << moved_gauges.min() << "/" << moved_gauges.max()
+                  << " (Expected: 24/-3/20)\n";
+        SharedListOperationsKit<int> gauge_snapshot(moved_gauges);
+        std::cout << "SharedListOperationsKit from aggregating list: " << gauge_snapshot << " (Expected: 7 -3 20)\n";
+        
+        AggregatingLinkedQueue<int, SumAggregate, WindowMinMaxAggregate> window;
+        std::vector<int> samples = {4, 2, 12, 3, 8, 1, 7, 7, 5};
+        std::cout << "Sliding window (3) min/max/sum: ";
+        for (int sample : samples) {
+            window.push(sample);
+            if (window.size() > 3) window.pop();
+            if (window.size() == 3) std::cout << window.min() << "/" << window.max() << "/" << window.sum() << " ";
+        }
+        std::cout << " (Expected: 2/12/18 2/12/17 3/12/23 1/8/12 1/8/16 1/7/15 5/7/19)\n";
+        try {
+            AggregatingLinkedQueue<int, WindowMinMaxAggregate> empty_window;
+            empty_window.min();
+        } catch (const std::runtime_error& e) {
+            std::cout << "min() on empty queue: " << e.what() << "\n";
+        }
+        
+        separator("35. Linked Priority Queue Tests");
+        
+        LinkedPriorityQueue<int> max_queue;
+        for (int value : {5, 1, 9, 3, 7, 9}) {
+            max_queue.push(value);
+        }
+        std::cout << "Pop order (max-queue): ";
+        while (!max_queue.empty()) {
+            std::cout << max_queue.top() << " ";
+            max_queue.pop();
+        }
+        std::cout << " (Expected: 9 9 7 5 3 1)\n";
+        
+        LinkedPriorityQueue<int, std::greater<int>> min_queue;
+        auto h40 = min_queue.insert(40);
+        auto h25 = min_queue.insert(25);
+        auto h60 = min_queue.insert(60);
+        min_queue.push(30);
+        min_queue.decrease_key(h60, 10);
+        std::cout << "top after decrease_key(60 -> 10): " << min_queue.top() << ", handle reads " << *h60 << " (Expected: 10, 10)\n";
+        min_queue.erase(h25);
+        min_queue.update(h40, 50);
+        std::cout << "Size after erase(25): " << min_queue.size() << " (Expected: 3)\n";
+        try {
+            min_queue.decrease_key(h40, 99);
+        } catch (const std::invalid_argument& e) {
+            std::cout << "decrease_key in the wrong direction: " << e.what() << "\n";
+        }
+        
+        LinkedPriorityQueue<int, std::greater<int>> other_queue;
+        auto h5 = other_queue.insert(5);
+        other_queue.push(45);
+        min_queue.merge(other_queue);
+        min_queue.decrease_key(h5, 1);
+        std::cout << "merge(): size " << min_queue.size() << ", other empty: " << (other_queue.empty() ? "Yes" : "No")
+                  << ", pop order: ";
+        while (!min_queue.empty()) {
+            std::cout << min_queue.top() << " ";
+            min_queue.pop();
+        }
+        std::cout << " (Expected: size 5, other empty: Yes, pop order: 1 10 30 45 50)\n";
+        
+        LinkedPriorityQueue<int> reuse_a;
+        LinkedPriorityQueue<int> reuse_b;
+        auto freed_a = reuse_a.insert(1);
+        reuse_a.push(2);
+        auto freed_b = reuse_b.insert(3);
+        reuse_b.push(4);
+        const int* slot_a = &*freed_a;
+        const int* slot_b = &*freed_b;
+        reuse_a.erase(freed_a);
+        reuse_b.erase(freed_b);
+        reuse_a.merge(reuse_b);
+        LinkedPriorityQueue<int> reuse_c;
+        auto freed_c = reuse_c.insert(7);
+        const int* slot_c = &*freed_c;
+        reuse_c.erase(freed_c);
+        reuse_c.merge(reuse_a);
+        std::vector<const int*> reused_slots;
+        for (int i = 0; i < 3; ++i) {
+            reused_slots.push_back(&*reuse_c.insert(10 + i));
+        }
+        std::vector<const int*> freed_slots = {slot_a, slot_b, slot_c};
+        std::sort(reused_slots.begin(), reused_slots.end());
+        std::sort(freed_slots.begin(), freed_slots.end());
+        std::cout << "Chained merge() keeps every free list: " << (reused_slots == freed_slots ? "Yes" : "No") << " (Expected: Yes)\n";
+        
+        LinkedPriorityQueue<std::string> words;
+        ::priority_queue<std::string>& words_interface = words;
+        for (const char* word : {"pear", "apple", "quince", "fig"}) {
+            words_interface.push(word);
+        }
+        words_interface.pop();
+        std::cout << "Through priority_queue<T>: top " << words_interface.top() << ", size " << words_interface.size()
+                  << " (Expected: top pear, size 3)\n";
+        try {
+            LinkedPriorityQueue<int> empty_heap;
+            empty_heap.top();
+        } catch (const std::runtime_error& e) {
+            std::cout << "top() on empty: " << e.what() << "\n";
+        }
+        
+        std::mt19937 heap_rng(7);
+        LinkedPriorityQueue<uint32_t, std::greater<uint32_t>> heap_stress;
+        std::vector<LinkedPriorityQueue<uint32_t, std::greater<uint32_t>>::handle> stress_handles;
+        for (int i = 0; i < 5000; ++i) {
+            stress_handles.push_back(heap_stress.insert(1'000'000 + heap_rng() % 1'000'000));
+        }
+        for (size_t i = 0; i < stress_handles.size(); i += 3) {
+            heap_stress.decrease_key(stress_handles[i], *stress_handles[i] - 1'000'000);
+        }
+        for (size_t i = 1; i < stress_handles.size(); i += 7) {
+            heap_stress.erase(stress_handles[i]);
+        }
+        bool heap_ordered = true;
+        uint32_t previous = 0;
+        size_t popped = 0;
+        while (!heap_stress.empty()) {
+            heap_ordered = heap_ordered && heap_stress.top() >= previous;
+            previous = heap_stress.top();
+            heap_stress.pop();
+            ++popped;
+        }
+        std::cout << "5000 inserts, decrease_key/erase mix: popped " << popped << " in order: " << (heap_ordered ? "Yes" : "No")
+                  << " (Expected: popped 4285 in order: Yes)\n";
+        
         separator("Test Complete");
         
         std::cout << "All tests executed successfully!\n";